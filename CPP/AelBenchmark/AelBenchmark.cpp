@@ -0,0 +1,94 @@
+/*******************************************************************************
+* Purpose   :  Benchmarks Clipper on sweeps with very wide AELs                *
+* License   :  http://www.boost.org/LICENSE_1_0.txt                            *
+*******************************************************************************/
+
+//nb: a stand-alone console program, eg
+//  g++ -std=c++11 -O2 -pthread -I.. AelBenchmark.cpp ../clipper.cpp -o AelBenchmark
+//To compare AEL index thresholds, add eg -DAEL_INDEX_MIN_WIDTH=1000000000
+//(which disables the index) to the command line.
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include "../clipper.h"
+
+using namespace clipperlib;
+
+//------------------------------------------------------------------------------
+// inputs
+//------------------------------------------------------------------------------
+
+static Paths SquaresGrid(int cols, int rows)
+{
+  //overlapping squares whose rows are staggered (and whose columns are a little
+  //uneven), so there are roughly 2 * cols edges in the AEL and plenty of local 
+  //minima to insert into it, but few intersections ...
+  Paths pp;
+  for (int r = 0; r < rows; ++r)
+    for (int c = 0; c < cols; ++c) {
+      int64_t x = c * 10 + (r % 2) * 5, y = r * 10 + (c % 7);
+      Path p;
+      p.push_back(Point64(x, y));
+      p.push_back(Point64(x + 12, y));
+      p.push_back(Point64(x + 12, y + 12));
+      p.push_back(Point64(x, y + 12));
+      pp.push_back(p);
+    }
+  return pp;
+}
+//------------------------------------------------------------------------------
+
+static Paths RandomPolygon(int vert_cnt)
+{
+  //a single polygon with random vertices, so its edges intersect everywhere
+  //and the sweep is kept busy with intersections rather than local minima ...
+  Path p;
+  for (int i = 0; i < vert_cnt; ++i)
+    p.push_back(Point64(rand() % 1000000, rand() % 1000000));
+  return Paths(1, p);
+}
+//------------------------------------------------------------------------------
+
+static double UnionTime(const Paths &subj, size_t &sol_cnt)
+{
+  //the best of 3 runs, in seconds ...
+  double result = 0;
+  for (int i = 0; i < 3; ++i) {
+    Clipper c;
+    c.AddPaths(subj, ptSubject);
+    Paths sol;
+    std::chrono::steady_clock::time_point t = std::chrono::steady_clock::now();
+    c.Execute(ctUnion, sol, frNonZero);
+    double secs = std::chrono::duration< double >(
+      std::chrono::steady_clock::now() - t).count();
+    if (i == 0 || secs < result) result = secs;
+    sol_cnt = sol.size();
+  }
+  return result;
+}
+
+//------------------------------------------------------------------------------
+// main
+//------------------------------------------------------------------------------
+
+int main()
+{
+  const int cols[] = { 64, 128, 256, 512, 1000, 2000, 4000 };
+  const int vert_cnts[] = { 250, 500, 1000, 2000, 4000 };
+  size_t sol_cnt;
+
+  for (size_t i = 0; i < sizeof(cols) / sizeof(cols[0]); ++i) {
+    double secs = UnionTime(SquaresGrid(cols[i], 40), sol_cnt);
+    printf("squares %4d x 40: %8.3f secs (%u paths)\n", 
+      cols[i], secs, (unsigned)sol_cnt);
+  }
+  for (size_t i = 0; i < sizeof(vert_cnts) / sizeof(vert_cnts[0]); ++i) {
+    srand(1);
+    double secs = UnionTime(RandomPolygon(vert_cnts[i]), sol_cnt);
+    printf("random polygon %4d: %8.3f secs (%u paths)\n", 
+      vert_cnts[i], secs, (unsigned)sol_cnt);
+  }
+  return 0;
+}
+//------------------------------------------------------------------------------
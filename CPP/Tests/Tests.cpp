@@ -0,0 +1,462 @@
+/*******************************************************************************
+* Purpose   :  Regression tests for the Clipper library                        *
+* License   :  http://www.boost.org/LICENSE_1_0.txt                            *
+*******************************************************************************/
+
+//nb: a stand-alone console program, eg
+//  g++ -std=c++11 -pthread -I.. Tests.cpp ../clipper*.cpp -o Tests
+//it returns the number of failed checks.
+
+#include <cstdio>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <new>
+#include "../clipper.h"
+#include "../clipper_offset.h"
+#include "../clipper_metrics.h"
+#include "../clipper_provenance.h"
+
+using namespace clipperlib;
+
+static int failures = 0;
+
+#define CHECK(cond) \
+  do { if (!(cond)) { ++failures; printf("%s(%d): failed: %s\n", __FILE__, __LINE__, #cond); } } while (0)
+
+//------------------------------------------------------------------------------
+// helpers
+//------------------------------------------------------------------------------
+
+static Path Rectangle(int64_t l, int64_t t, int64_t r, int64_t b)
+{
+  Path p;
+  p.push_back(Point64(l, t));
+  p.push_back(Point64(r, t));
+  p.push_back(Point64(r, b));
+  p.push_back(Point64(l, b));
+  return p;
+}
+//------------------------------------------------------------------------------
+
+static Paths Grid(int cnt, int64_t size, int64_t step)
+{
+  //a grid of overlapping squares, plus a diamond over the lot so there are
+  //plenty of intersections and local maxima ...
+  Paths pp;
+  for (int i = 0; i < cnt; ++i)
+    for (int j = 0; j < cnt; ++j)
+      pp.push_back(Rectangle(i * step, j * step, i * step + size, j * step + size));
+  int64_t m = cnt * step / 2;
+  Path d;
+  d.push_back(Point64(m, -step));
+  d.push_back(Point64(cnt * step + step, m));
+  d.push_back(Point64(m, cnt * step + step));
+  d.push_back(Point64(-step, m));
+  pp.push_back(d);
+  return pp;
+}
+//------------------------------------------------------------------------------
+
+static bool PointLess(const Point64 &a, const Point64 &b)
+{
+  return a.y < b.y || (a.y == b.y && a.x < b.x);
+}
+//------------------------------------------------------------------------------
+
+static bool PathLess(const Path &a, const Path &b)
+{
+  return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(), PointLess);
+}
+//------------------------------------------------------------------------------
+
+static void Normalize(Paths &pp)
+{
+  //paths (and their starts) may come in any order ...
+  for (size_t i = 0; i < pp.size(); ++i)
+    std::rotate(pp[i].begin(), std::min_element(pp[i].begin(), pp[i].end(), PointLess), pp[i].end());
+  std::sort(pp.begin(), pp.end(), PathLess);
+}
+//------------------------------------------------------------------------------
+
+static bool SamePaths(Paths a, Paths b)
+{
+  Normalize(a);
+  Normalize(b);
+  return a == b;
+}
+//------------------------------------------------------------------------------
+
+static double Area(const Paths &paths)
+{
+  double a = 0;
+  for (size_t i = 0; i < paths.size(); ++i) {
+    const Path &p = paths[i];
+    for (size_t j = 0, k = p.size() - 1; j < p.size(); k = j++)
+      a += (double(p[k].x) + p[j].x) * (double(p[k].y) - p[j].y);
+  }
+  return -a * 0.5;
+}
+//------------------------------------------------------------------------------
+
+static Paths Clip(ClipType ct, const Paths &subj, const Paths &clip, FillRule fr)
+{
+  Clipper c;
+  c.AddPaths(subj, ptSubject);
+  c.AddPaths(clip, ptClip);
+  Paths sol;
+  c.Execute(ct, sol, fr);
+  return sol;
+}
+
+//------------------------------------------------------------------------------
+// Execute after an earlier Execute threw
+//------------------------------------------------------------------------------
+
+class ThrowingClipper : public Clipper
+{
+  public:
+    int throw_at; //the scanbeam that throws (-1: none)
+    int scanbeam;
+    ThrowingClipper() : throw_at(-1), scanbeam(0) {}
+  protected:
+    void DoScanbeam(const int64_t /*bot_y*/, const int64_t /*top_y*/)
+    {
+      if (scanbeam++ == throw_at) throw ClipperException("scanbeam");
+    }
+};
+//------------------------------------------------------------------------------
+
+static void TestExecuteAfterThrow(bool pipelined)
+{
+  Paths subj = Grid(12, 30, 20), clip = Grid(7, 45, 33), sol;
+  Paths expected = Clip(ctIntersection, subj, clip, frNonZero);
+  CHECK(!expected.empty());
+
+  ThrowingClipper c;
+  c.PipelinedExecute(pipelined);
+  c.AddPaths(subj, ptSubject);
+  c.AddPaths(clip, ptClip);
+  //throw part way through the sweep (ie when edges are waiting at local 
+  //maxima vertices for their partners) ...
+  for (int i = 1; i < 40; i += 7) {
+    c.throw_at = i;
+    c.scanbeam = 0;
+    bool threw = false;
+    try {
+      c.Execute(ctIntersection, sol, frNonZero);
+    }
+    catch (const ClipperException&) {
+      threw = true;
+    }
+    CHECK(threw);
+  }
+  c.throw_at = -1;
+  CHECK(c.Execute(ctIntersection, sol, frNonZero));
+  CHECK(SamePaths(sol, expected));
+  //and again with different paths ...
+  c.Clear();
+  c.AddPaths(clip, ptSubject);
+  c.AddPaths(subj, ptClip);
+  CHECK(c.Execute(ctUnion, sol, frNonZero));
+  CHECK(SamePaths(sol, Clip(ctUnion, clip, subj, frNonZero)));
+}
+
+//------------------------------------------------------------------------------
+// Execute after a MemoryResource failed
+//------------------------------------------------------------------------------
+
+class FailingResource : public MemoryResource
+{
+  public:
+    size_t alloc_cnt;
+    size_t live_cnt;
+    size_t fail_at; //the allocation that throws (0: none)
+    FailingResource() : alloc_cnt(0), live_cnt(0), fail_at(0) {}
+    void *Allocate(size_t bytes)
+    {
+      if (++alloc_cnt == fail_at) throw std::bad_alloc();
+      ++live_cnt;
+      return ::operator new(bytes);
+    }
+    void Deallocate(void *p, size_t /*bytes*/)
+    {
+      --live_cnt;
+      ::operator delete(p);
+    }
+};
+//------------------------------------------------------------------------------
+
+static void TestExecuteAfterBadAlloc()
+{
+  Paths subj = Grid(12, 30, 20), clip = Grid(7, 45, 33), sol;
+  Paths expected = Clip(ctXor, subj, clip, frNonZero);
+
+  FailingResource mr;
+  {
+    Clipper c(&mr);
+    c.AddPaths(subj, ptSubject);
+    c.AddPaths(clip, ptClip);
+    //count the allocations made by an Execute (once the engine's arenas
+    //have grown to size) ...
+    CHECK(c.Execute(ctXor, sol, frNonZero));
+    size_t cnt = mr.alloc_cnt;
+    CHECK(c.Execute(ctXor, sol, frNonZero));
+    cnt = mr.alloc_cnt - cnt;
+    CHECK(cnt > 0);
+    //then fail each of them in turn (or a spread of them) ...
+    size_t step = cnt / 50 + 1;
+    for (size_t i = 1; i <= cnt; i += step) {
+      mr.fail_at = mr.alloc_cnt + i;
+      bool threw = false;
+      try {
+        c.Execute(ctXor, sol, frNonZero);
+      }
+      catch (const std::bad_alloc&) {
+        threw = true;
+      }
+      CHECK(threw);
+      mr.fail_at = 0;
+      CHECK(c.Execute(ctXor, sol, frNonZero));
+      CHECK(SamePaths(sol, expected));
+    }
+  }
+  CHECK(mr.live_cnt == 0);
+}
+
+//------------------------------------------------------------------------------
+// SavePrepared & LoadPrepared
+//------------------------------------------------------------------------------
+
+static bool LoadThrows(Clipper &c, const std::vector< char > &blob)
+{
+  try {
+    c.LoadPrepared(&blob[0], blob.size());
+  }
+  catch (const ClipperException&) {
+    return true;
+  }
+  return false;
+}
+//------------------------------------------------------------------------------
+
+static void TestLoadPrepared()
+{
+  Paths subj = Grid(5, 30, 20), clip = Grid(3, 45, 33), sol, sol2;
+  Path line;
+  line.push_back(Point64(-10, -10));
+  line.push_back(Point64(150, 170));
+  std::vector< char > blob;
+  {
+    Clipper c;
+    c.AddPaths(subj, ptSubject);
+    c.AddPaths(clip, ptClip);
+    c.AddPath(line, ptSubject, true);
+    c.SavePrepared(blob);
+    Paths open, open2;
+    CHECK(c.Execute(ctIntersection, sol, open, frNonZero));
+    Clipper c2;
+    c2.LoadPrepared(&blob[0], blob.size());
+    CHECK(c2.Execute(ctIntersection, sol2, open2, frNonZero));
+    CHECK(SamePaths(sol, sol2));
+    CHECK(open.size() == 1 && open == open2);
+  }
+
+  //an open path's minima can't be a clip path's. nb: a blob ends with its
+  //minima, here just the line's: {ring, offset (both int64), path_id, 
+  //polytype (both int32), is_open (int64)} ...
+  std::vector< char > bad;
+  Clipper c;
+  c.AddPath(line, ptSubject, true);
+  c.SavePrepared(bad);
+  int32_t polytype = ptClip;
+  memcpy(&bad[bad.size() - 12], &polytype, sizeof(polytype));
+  CHECK(LoadThrows(c, bad));
+  CHECK(!LoadThrows(c, blob));
+
+  //and ClipperProvenance refuses blobs since they don't hold its path types
+  ClipperProvenance cp;
+  CHECK(LoadThrows(cp, blob));
+}
+
+//------------------------------------------------------------------------------
+// ClipperOffset
+//------------------------------------------------------------------------------
+
+static Paths Union(const Paths &subj)
+{
+  return Clip(ctUnion, subj, Paths(), frNonZero);
+}
+//------------------------------------------------------------------------------
+
+static void TestOffsetMixedOrientations()
+{
+  //a square with a hole (from a PolyTree, so oriented) and a separate square
+  //that's lower and reversed, so the unoriented paths are negated ...
+  Paths ring, tmp;
+  ring.push_back(Rectangle(0, 0, 100, 100));
+  PolyTree tree;
+  {
+    Clipper c;
+    c.AddPaths(ring, ptSubject);
+    c.AddPath(Rectangle(30, 30, 70, 70), ptClip);
+    c.Execute(ctDifference, tree, tmp);
+  }
+  Paths square = Union(Paths(1, Rectangle(300, 300, 400, 400)));
+  Paths reversed = square;
+  std::reverse(reversed[0].begin(), reversed[0].end());
+
+  Paths sol1, sol2, sol;
+  ClipperOffset co1, co2, co;
+  co1.AddPolyTree(tree, kMiter);
+  co1.Execute(sol1, 10);
+  co2.AddPaths(square, kMiter, kPolygon);
+  co2.Execute(sol2, 10);
+  sol1.insert(sol1.end(), sol2.begin(), sol2.end());
+  CHECK(sol1.size() == 3);
+
+  co.AddPolyTree(tree, kMiter);
+  co.AddPaths(reversed, kMiter, kPolygon);
+  co.Execute(sol, 10);
+  CHECK(SamePaths(Union(sol), Union(sol1)));
+
+  PolyTree sol_tree;
+  co.Execute(sol_tree, 10);
+  CHECK(sol_tree.ChildCount() == 2);
+}
+
+//------------------------------------------------------------------------------
+
+static void TestOffsetSparseGroups()
+{
+  //group ids needn't be dense ...
+  ClipperOffset co;
+  co.AddPath(Rectangle(0, 0, 100, 100), kMiter, kPolygon, 1000000000);
+  co.AddPath(Rectangle(200, 0, 300, 100), kMiter, kPolygon, 5);
+  co.AddPath(Rectangle(250, 50, 350, 150), kMiter, kPolygon, 5);
+  co.AddPath(Rectangle(0, 200, 100, 300), kMiter, kPolygon, UINT_MAX);
+  PathsList sols;
+  std::vector< unsigned > ids;
+  co.Execute(sols, ids, 10, 2);
+  CHECK(ids.size() == 3 && sols.size() == 3);
+  if (ids.size() != 3 || sols.size() != 3) return;
+  CHECK(ids[0] == 5 && ids[1] == 1000000000 && ids[2] == UINT_MAX);
+  CHECK(sols[0].size() == 1 && sols[1].size() == 1 && sols[2].size() == 1);
+
+  //and each group's solution is that of the group's paths alone ...
+  ClipperOffset co5;
+  co5.AddPath(Rectangle(200, 0, 300, 100), kMiter, kPolygon);
+  co5.AddPath(Rectangle(250, 50, 350, 150), kMiter, kPolygon);
+  Paths sol5;
+  co5.Execute(sol5, 10);
+  CHECK(SamePaths(sols[0], sol5));
+}
+
+//------------------------------------------------------------------------------
+// ClipperMetrics
+//------------------------------------------------------------------------------
+
+static void CheckMetrics(ClipType ct, const Paths &subj, const Paths &clip, 
+  FillRule fr, double expected_area)
+{
+  Paths sol = Clip(ct, subj, clip, fr);
+  ClipperMetrics cm;
+  cm.AddPaths(subj, ptSubject);
+  cm.AddPaths(clip, ptClip);
+  ClipMetrics metrics;
+  CHECK(cm.Execute(ct, metrics, fr));
+  CHECK(metrics.area == expected_area);
+  CHECK(Area(sol) == expected_area);
+  CHECK(metrics.count == sol.size());
+}
+//------------------------------------------------------------------------------
+
+static void TestMetricsDegenerate()
+{
+  //two triangles that share an edge, less a triangle that touches them at a
+  //vertex (this ring had sides that swapped before it was reversed) ...
+  Paths subj, clip;
+  Path p;
+  p.push_back(Point64(10, 15)); p.push_back(Point64(13, 7)); p.push_back(Point64(7, 7));
+  subj.push_back(p);
+  p.clear();
+  p.push_back(Point64(7, 7)); p.push_back(Point64(13, 7)); p.push_back(Point64(10, 11));
+  subj.push_back(p);
+  p.clear();
+  p.push_back(Point64(7, 7)); p.push_back(Point64(9, 7)); p.push_back(Point64(7, 2));
+  clip.push_back(p);
+  CheckMetrics(ctXor, subj, clip, frNonZero, 17);
+
+  //repeated and collinear vertices ...
+  subj.clear();
+  p.clear();
+  p.push_back(Point64(0, 0)); p.push_back(Point64(0, 0)); p.push_back(Point64(5, 0)); 
+  p.push_back(Point64(10, 0)); p.push_back(Point64(10, 5)); p.push_back(Point64(10, 5)); 
+  p.push_back(Point64(10, 10)); p.push_back(Point64(0, 10)); p.push_back(Point64(0, 5));
+  subj.push_back(p);
+  clip.clear();
+  clip.push_back(Rectangle(5, 5, 15, 15));
+  clip[0].insert(clip[0].begin() + 1, clip[0][1]);
+  CheckMetrics(ctUnion, subj, clip, frNonZero, 175);
+  CheckMetrics(ctIntersection, subj, clip, frNonZero, 25);
+  CheckMetrics(ctDifference, subj, clip, frNonZero, 75);
+  CheckMetrics(ctXor, subj, clip, frNonZero, 150);
+
+  //the solution's paths are never built ...
+  ClipperMetrics cm;
+  cm.AddPaths(subj, ptSubject);
+  Paths sol;
+  bool threw = false;
+  try { cm.Execute(ctUnion, sol); }
+  catch (const ClipperException&) { threw = true; }
+  CHECK(threw);
+}
+
+//------------------------------------------------------------------------------
+// ParallelIntersections
+//------------------------------------------------------------------------------
+
+static void TestParallelIntersections()
+{
+  //a row of overlapping squares under a sawtooth, wide enough for several
+  //threads, and Executed twice (so the threads are started twice) ...
+  Paths subj, clip;
+  for (int i = 0; i < 5000; ++i) subj.push_back(Rectangle(i * 10, 0, i * 10 + 12, 12));
+  Path saw;
+  for (int i = 0; i <= 5000; ++i) saw.push_back(Point64(i * 10, i % 2 ? -5 : 20));
+  saw.push_back(Point64(50000, 30));
+  saw.push_back(Point64(0, 30));
+  clip.push_back(saw);
+  Paths expected = Clip(ctIntersection, subj, clip, frNonZero);
+  CHECK(!expected.empty());
+
+  Clipper c;
+  c.ParallelIntersections(1, 4);
+  c.AddPaths(subj, ptSubject);
+  c.AddPaths(clip, ptClip);
+  for (int i = 0; i < 2; ++i) {
+    Paths sol;
+    c.Execute(ctIntersection, sol, frNonZero);
+    CHECK(sol == expected);
+  }
+}
+
+//------------------------------------------------------------------------------
+// main
+//------------------------------------------------------------------------------
+
+int main()
+{
+  TestExecuteAfterThrow(false);
+  TestExecuteAfterThrow(true);
+  TestExecuteAfterBadAlloc();
+  TestLoadPrepared();
+  TestOffsetMixedOrientations();
+  TestOffsetSparseGroups();
+  TestMetricsDegenerate();
+  TestParallelIntersections();
+  if (failures) printf("%d check(s) failed\n", failures);
+  else printf("all tests passed\n");
+  return failures;
+}
+//------------------------------------------------------------------------------
@@ -17,6 +17,13 @@
 #include <cstring>
 #include <ostream>
 #include <functional>
+#include <new>
+#include <atomic>
+#include <thread>
+#include <exception>
+#include <mutex>
+#include <condition_variable>
+#include <system_error>
 #include "clipper.h"
 
 namespace clipperlib {
@@ -32,12 +39,14 @@ namespace clipperlib {
     Vertex      *next;
     Vertex      *prev;
     VertexFlags  flags;
+    Active      *max_e;        //first bound to reach this (local maxima) vertex
   };
 
   struct LocalMinima {
     Vertex      *vertex;
     PathType     polytype;
     bool         is_open;
+    int          path_id;  //the index of the input path (in the order added)
   };
 
   struct Scanline {
@@ -51,12 +60,217 @@ namespace clipperlib {
     Active      *edge2;
   };
 
+  //AelNode & AelIndex: an (optional) skip list over the AEL that's only built
+  //once the AEL gets very wide. Nodes are ordered by AEL position rather than
+  //by key, so when edges swap positions in the AEL, their nodes simply swap
+  //edges. The AEL is only sorted by curr.x when local minima are being
+  //inserted, and that's the only time the index is searched by curr.x.
+  //Each link also carries totals (AelSpan) for the nodes it spans, so winding
+  //counts and the nearest hot edge can be found without walking the AEL.
+  //Only the levels up to the tallest node's are walked; above that, head's
+  //spans simply hold the totals for the whole AEL.
+  //Every intersection costs the index a swap (and usually updates too), so
+  //it's dropped once these outweigh the AEL walks that it's saved (roughly
+  //AEL_INDEX_SWAP_COST walk steps per swap). (Below about 1000 edges, the
+  //index costs more than it saves; see AelBenchmark.)
+#ifndef AEL_INDEX_MIN_WIDTH
+  #define AEL_INDEX_MIN_WIDTH (1024)
+#endif
+  #define AEL_INDEX_MAX_LEVEL (16)
+  #define AEL_INDEX_SWAP_COST (8)
+  #define AEL_HOT_CNT         (2)
+
+  struct AelSpan {
+    int          cnt[3];       //closed edges of each PathType, then hot closed edges
+    int          wind[2];      //wind_dx totals of closed edges of each PathType
+  };
+
+  struct AelNode {
+    Active      *edge;
+    int          height;
+    AelNode    **next;         //next[0 .. height-1]
+    AelNode    **prev;         //prev[0 .. height-1]
+    AelSpan     *span;         //span[i]: totals for nodes from this up to next[i]
+    AelSpan      own;          //ie this node's contribution
+  };
+
+  struct AelIndex {
+    AelNode      head;
+    AelNode     *head_links[AEL_INDEX_MAX_LEVEL * 2];
+    AelSpan      head_spans[AEL_INDEX_MAX_LEVEL];
+    int          levels;       //the tallest node's height
+    size_t       saved;        //AEL walk steps saved (roughly)
+    size_t       swaps;
+    unsigned     seed;
+    MemoryResource *mr;
+    explicit AelIndex(MemoryResource *mr_);
+    ~AelIndex();
+    AelNode* NewNode(Active &e);
+    void DisposeNode(AelNode *n);
+    void AddToSpans(AelNode *n, int lvl, const AelSpan &delta, int sign);
+    void InsertAfter(AelNode *pos, Active &e);
+    void Remove(Active &e);
+    void MoveAfter(Active &e, Active &e_left);
+    void Swap(Active &e1, Active &e2);
+    void Update(Active &e);
+    void Prefix(const Active &e, AelSpan &result) const;
+    Active* FindPrev(const Active &e, int cnt_idx) const;
+    Active* FindNext(const Active &e, int cnt_idx) const;
+    AelNode* FindInsertPos(const Active &e) const;
+  };
+
   struct LocMinSorter {
     inline bool operator()(const LocalMinima* locMin1, const LocalMinima* locMin2) {
       return locMin2->vertex->pt.y < locMin1->vertex->pt.y;
     }
   };
 
+  //------------------------------------------------------------------------------
+  // MemoryResource methods ...
+  //------------------------------------------------------------------------------
+
+  class HeapMemoryResource : public MemoryResource
+  {
+    public:
+      void *Allocate(size_t bytes) { return ::operator new(bytes); }
+      void Deallocate(void *p, size_t /*bytes*/) { ::operator delete(p); }
+  };
+  //------------------------------------------------------------------------------
+
+  MemoryResource *DefaultMemoryResource()
+  {
+    static HeapMemoryResource heap;
+    return &heap;
+  }
+  //------------------------------------------------------------------------------
+
+  //------------------------------------------------------------------------------
+  // WorkerJob methods & RunWorkers ...
+  //------------------------------------------------------------------------------
+
+  void WorkerJob::SetError()
+  {
+    //keep the first error only, and this also stops the other workers
+    if (!failed.exchange(true)) error = std::current_exception();
+  }
+  //------------------------------------------------------------------------------
+
+  static void RunWorker(WorkerFunc worker, WorkerJob *job)
+  {
+    try {
+      worker(job);
+    }
+    catch (...) {
+      job->SetError();
+    }
+  }
+  //------------------------------------------------------------------------------
+
+  void RunWorkers(WorkerJob &job, WorkerFunc worker, unsigned thread_cnt, 
+    size_t max_threads)
+  {
+    if (!thread_cnt) thread_cnt = std::thread::hardware_concurrency();
+    if (thread_cnt > max_threads) thread_cnt = unsigned(max_threads);
+    std::vector< std::thread > threads;
+    if (thread_cnt > 1) {
+      threads.reserve(thread_cnt - 1);
+      try {
+        for (unsigned i = 1; i < thread_cnt; ++i)
+          threads.push_back(std::thread(RunWorker, worker, &job));
+      }
+      catch (const std::system_error&) {
+        //ie no more threads, so make do with those already started
+      }
+    }
+    RunWorker(worker, &job);
+    for (size_t i = 0; i < threads.size(); ++i) threads[i].join();
+    if (job.failed) std::rethrow_exception(job.error);
+  }
+  //------------------------------------------------------------------------------
+
+  //WorkerPool: threads that are kept (waiting) from one job to the next, for
+  //work that's shared among threads many times over (eg every scanbeam), where
+  //starting threads for each job (as RunWorkers does) would cost too much.
+  //Run() returns once every thread has finished the job (ie it's a barrier).
+  struct WorkerPool {
+    std::mutex         mutex;
+    std::condition_variable start_cv; //a new job (or quit)
+    std::condition_variable done_cv;  //every thread has finished the job
+    std::vector< std::thread > threads;
+    WorkerJob         *job;
+    WorkerFunc         worker;
+    size_t             job_id;        //incremented for each job
+    size_t             busy_cnt;      //threads yet to finish the job
+    bool               quit;
+    explicit WorkerPool(unsigned thread_cnt);
+    ~WorkerPool();
+    void Run(WorkerJob &job_, WorkerFunc worker_);
+  };
+
+  static void PoolThread(WorkerPool *pool)
+  {
+    size_t job_id = 0;
+    std::unique_lock< std::mutex > lock(pool->mutex);
+    for (;;) {
+      while (!pool->quit && pool->job_id == job_id) pool->start_cv.wait(lock);
+      if (pool->quit) return;
+      job_id = pool->job_id;
+      WorkerJob *job = pool->job;
+      WorkerFunc worker = pool->worker;
+      lock.unlock();
+      RunWorker(worker, job);
+      lock.lock();
+      if (--pool->busy_cnt == 0) pool->done_cv.notify_one();
+    }
+  }
+  //------------------------------------------------------------------------------
+
+  WorkerPool::WorkerPool(unsigned thread_cnt) : 
+    job(NULL), worker(NULL), job_id(0), busy_cnt(0), quit(false)
+  {
+    //the thread that calls Run is always one of thread_cnt ...
+    if (thread_cnt < 2) return;
+    threads.reserve(thread_cnt - 1);
+    try {
+      for (unsigned i = 1; i < thread_cnt; ++i)
+        threads.push_back(std::thread(PoolThread, this));
+    }
+    catch (const std::system_error&) {
+      //ie no more threads, so make do with those already started
+    }
+  }
+  //------------------------------------------------------------------------------
+
+  WorkerPool::~WorkerPool()
+  {
+    {
+      std::lock_guard< std::mutex > lock(mutex);
+      quit = true;
+    }
+    start_cv.notify_all();
+    for (size_t i = 0; i < threads.size(); ++i) threads[i].join();
+  }
+  //------------------------------------------------------------------------------
+
+  void WorkerPool::Run(WorkerJob &job_, WorkerFunc worker_)
+  {
+    {
+      std::lock_guard< std::mutex > lock(mutex);
+      job = &job_;
+      worker = worker_;
+      busy_cnt = threads.size();
+      ++job_id;
+    }
+    start_cv.notify_all();
+    RunWorker(worker_, &job_);
+    {
+      std::unique_lock< std::mutex > lock(mutex);
+      while (busy_cnt) done_cv.wait(lock);
+    }
+    if (job_.failed) std::rethrow_exception(job_.error);
+  }
+  //------------------------------------------------------------------------------
+
   //------------------------------------------------------------------------------
   // PolyTree (PolyPath) methods ...
   //------------------------------------------------------------------------------
@@ -65,14 +279,17 @@ namespace clipperlib {
   {
     for (size_t i = 0; i < childs_.size(); ++i) {
       childs_[i]->Clear();
-      delete childs_[i];
+      childs_[i]->~PolyPath();
+      mr_->Deallocate(childs_[i], sizeof(PolyPath));
     }
     childs_.resize(0);
   }
   //------------------------------------------------------------------------------
 
-  PolyPath::PolyPath(PolyPath *parent, const Path &path) :
-      parent_(parent), path_(path)
+  PolyPath::PolyPath(PolyPath *parent, const Path &path, MemoryResource *mr) :
+      parent_(parent), path_(path), 
+      mr_(mr ? mr : (parent ? parent->mr_ : DefaultMemoryResource())),
+      childs_(ResourceAllocator< PolyPath* >(mr_))
   {
   }
   //------------------------------------------------------------------------------
@@ -83,7 +300,15 @@ namespace clipperlib {
 
   PolyPath& PolyPath::AddChild(const Path &path)
   {
-    PolyPath* child = new PolyPath(this, path);
+    void *mem = mr_->Allocate(sizeof(PolyPath));
+    PolyPath* child;
+    try {
+      child = new (mem) PolyPath(this, path);
+    }
+    catch (...) {
+      mr_->Deallocate(mem, sizeof(PolyPath));
+      throw;
+    }
     childs_.push_back(child);
     return *child;
   }
@@ -137,7 +362,7 @@ namespace clipperlib {
   inline bool IsHotEdge(const Active &e) { return (e.outrec); }
   //------------------------------------------------------------------------------
 
-  inline bool IsOpen(const Active &e) { return (e.local_min->is_open); }
+  inline bool IsOpen(const Active &e) { return e.is_open; }
   //------------------------------------------------------------------------------
 
   inline bool IsStartSide(const Active &e) { return (&e == e.outrec->start_e); }
@@ -152,21 +377,22 @@ namespace clipperlib {
   }
   //------------------------------------------------------------------------------
 
-  bool FixOrientation(Active &e)
+  //ReverseSides: SwapSides only moves the gap between the path's two ends, so
+  //for a closed path whose sides must swap, the ring is reversed too (so the
+  //points added to each side later still extend the right end of the path).
+  inline void ReverseSides(OutRec &outrec)
   {
-    bool result = true;
-    Active* e2 = &e;
-    while (e2->prev_in_ael) {
-      e2 = e2->prev_in_ael;
-      if (e2->outrec && !IsOpen(*e2)) result = !result;
-    }
-    if (result != IsStartSide(e)) {
-      if (result) e.outrec->flag = orOuter;
-      else e.outrec->flag = orInner;
-      SwapSides(*e.outrec);
-      return true; //all fixed
-    }
-    else return false; //no fix needed
+    OutPt *end_op = outrec.pts->next, *op = end_op;
+    do {
+      OutPt *next = op->next;
+      op->next = op->prev;
+      op->prev = next;
+      op = next;
+    } while (op != end_op);
+    Active *e2 = outrec.start_e;
+    outrec.start_e = outrec.end_e;
+    outrec.end_e = e2;
+    outrec.pts = end_op;
   }
   //------------------------------------------------------------------------------
 
@@ -222,12 +448,288 @@ namespace clipperlib {
   }
   //------------------------------------------------------------------------------
 
-  inline PathType GetPolyType(const Active &e) { return e.local_min->polytype; }
+  inline PathType GetPolyType(const Active &e) { return e.polytype; }
   //------------------------------------------------------------------------------
 
   inline bool IsSamePolyType(const Active &e1, const Active &e2)
   {
-    return e1.local_min->polytype == e2.local_min->polytype;
+    return e1.polytype == e2.polytype;
+  }
+  //------------------------------------------------------------------------------
+
+  inline void ClearSpan(AelSpan &s)
+  {
+    s.cnt[0] = 0; s.cnt[1] = 0; s.cnt[2] = 0;
+    s.wind[0] = 0; s.wind[1] = 0;
+  }
+  //------------------------------------------------------------------------------
+
+  inline void AddSpan(AelSpan &s, const AelSpan &s2, int sign)
+  {
+    s.cnt[0] += sign * s2.cnt[0];
+    s.cnt[1] += sign * s2.cnt[1];
+    s.cnt[2] += sign * s2.cnt[2];
+    s.wind[0] += sign * s2.wind[0];
+    s.wind[1] += sign * s2.wind[1];
+  }
+  //------------------------------------------------------------------------------
+
+  inline void GetEdgeSpan(const Active &e, AelSpan &s)
+  {
+    ClearSpan(s);
+    if (IsOpen(e)) return;
+    s.cnt[GetPolyType(e)] = 1;
+    s.wind[GetPolyType(e)] = e.wind_dx;
+    if (IsHotEdge(e)) s.cnt[AEL_HOT_CNT] = 1;
+  }
+  //------------------------------------------------------------------------------
+
+  //------------------------------------------------------------------------------
+  // AelIndex methods ...
+  //------------------------------------------------------------------------------
+
+  AelIndex::AelIndex(MemoryResource *mr_) : 
+    levels(1), saved(0), swaps(0), seed(0x2545F491), mr(mr_)
+  {
+    head.edge = NULL;
+    head.height = AEL_INDEX_MAX_LEVEL;
+    head.next = head_links;
+    head.prev = head_links + AEL_INDEX_MAX_LEVEL;
+    head.span = head_spans;
+    ClearSpan(head.own);
+    for (int i = 0; i < AEL_INDEX_MAX_LEVEL * 2; ++i) head_links[i] = NULL;
+    for (int i = 0; i < AEL_INDEX_MAX_LEVEL; ++i) ClearSpan(head_spans[i]);
+  }
+  //------------------------------------------------------------------------------
+
+  AelIndex::~AelIndex()
+  {
+    AelNode *n = head.next[0];
+    while (n) {
+      AelNode *tmp = n;
+      n = n->next[0];
+      tmp->edge->ael_node = NULL;
+      DisposeNode(tmp);
+    }
+  }
+  //------------------------------------------------------------------------------
+
+  inline size_t AelNodeSize(int height)
+  {
+    //each node shares one allocation with its links and then its spans ...
+    return sizeof(AelNode) + height * (2 * sizeof(AelNode*) + sizeof(AelSpan));
+  }
+  //------------------------------------------------------------------------------
+
+  inline AelNode* SpanOwner(AelNode *n, int lvl)
+  {
+    //returns the node whose level 'lvl' link spans n ...
+    while (n->height <= lvl) n = n->prev[n->height - 1];
+    return n;
+  }
+  //------------------------------------------------------------------------------
+
+  AelNode* AelIndex::NewNode(Active &e)
+  {
+    //geometric distribution of node heights (p = 1/4) ...
+    seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+    int height = 1;
+    unsigned r = seed;
+    while (height < AEL_INDEX_MAX_LEVEL && (r & 3) == 0) { ++height; r >>= 2; }
+    if (height > levels) levels = height;
+
+    AelNode *n = new (mr->Allocate(AelNodeSize(height))) AelNode();
+    n->edge = &e;
+    n->height = height;
+    n->next = reinterpret_cast<AelNode**>(n + 1);
+    n->prev = n->next + height;
+    n->span = reinterpret_cast<AelSpan*>(n->prev + height);
+    GetEdgeSpan(e, n->own);
+    e.ael_node = n;
+    return n;
+  }
+  //------------------------------------------------------------------------------
+
+  void AelIndex::DisposeNode(AelNode *n)
+  {
+    mr->Deallocate(n, AelNodeSize(n->height));
+  }
+  //------------------------------------------------------------------------------
+
+  void AelIndex::AddToSpans(AelNode *n, int lvl, const AelSpan &delta, int sign)
+  {
+    //add delta to each span, from level 'lvl' up, that contains n ...
+    for (; lvl < levels; ++lvl) {
+      n = SpanOwner(n, lvl);
+      AddSpan(n->span[lvl], delta, sign);
+    }
+    for (; lvl < AEL_INDEX_MAX_LEVEL; ++lvl) AddSpan(head.span[lvl], delta, sign);
+  }
+  //------------------------------------------------------------------------------
+
+  void AelIndex::InsertAfter(AelNode *pos, Active &e)
+  {
+    AelNode *n = NewNode(e);
+    AelNode *p = pos;
+    n->span[0] = n->own;
+    for (int lvl = 0; lvl < n->height; ++lvl) {
+      //find the nearest node (at or before pos) that's tall enough, while
+      //totalling the level below from there to n ...
+      AelSpan to_n;
+      ClearSpan(to_n);
+      if (lvl > 0) {
+        AddSpan(to_n, p->span[lvl - 1], 1);
+        while (p->height <= lvl) {
+          p = p->prev[lvl - 1];
+          AddSpan(to_n, p->span[lvl - 1], 1);
+        }
+        //p's old span is now split between p and n ...
+        n->span[lvl] = p->span[lvl];
+        AddSpan(n->span[lvl], to_n, -1);
+        AddSpan(n->span[lvl], n->own, 1);
+        p->span[lvl] = to_n;
+      }
+      n->next[lvl] = p->next[lvl];
+      if (n->next[lvl]) n->next[lvl]->prev[lvl] = n;
+      n->prev[lvl] = p;
+      p->next[lvl] = n;
+    }
+    //and the taller links spanning n ...
+    AddToSpans(p, n->height, n->own, 1);
+  }
+  //------------------------------------------------------------------------------
+
+  void AelIndex::Remove(Active &e)
+  {
+    AelNode *n = e.ael_node;
+    if (!n) return;
+    AelNode *p = NULL;
+    for (int lvl = 0; lvl < n->height; ++lvl) {
+      p = n->prev[lvl];
+      AddSpan(p->span[lvl], n->span[lvl], 1);
+      AddSpan(p->span[lvl], n->own, -1);
+      p->next[lvl] = n->next[lvl];
+      if (n->next[lvl]) n->next[lvl]->prev[lvl] = p;
+    }
+    AddToSpans(p, n->height, n->own, -1);
+    e.ael_node = NULL;
+    DisposeNode(n);
+  }
+  //------------------------------------------------------------------------------
+
+  void AelIndex::MoveAfter(Active &e, Active &e_left)
+  {
+    Remove(e);
+    InsertAfter(e_left.ael_node, e);
+  }
+  //------------------------------------------------------------------------------
+
+  void AelIndex::Update(Active &e)
+  {
+    //refresh the totals after e's contribution has changed (ie hot or not) ...
+    AelNode *n = e.ael_node;
+    if (!n) return;
+    AelSpan delta;
+    GetEdgeSpan(e, delta);
+    AddSpan(delta, n->own, -1);
+    if (!delta.cnt[0] && !delta.cnt[1] && !delta.cnt[2] &&
+      !delta.wind[0] && !delta.wind[1]) return;
+    AddSpan(n->own, delta, 1);
+    AddToSpans(n, 0, delta, 1);
+  }
+  //------------------------------------------------------------------------------
+
+  void AelIndex::Swap(Active &e1, Active &e2)
+  {
+    AelNode *n1 = e1.ael_node, *n2 = e2.ael_node;
+    e1.ael_node = n2;
+    e2.ael_node = n1;
+    n1->edge = &e2;
+    n2->edge = &e1;
+    if (n2->next[0] == n1) { n1 = n2; n2 = e2.ael_node; }
+    if (n1->next[0] == n2) {
+      //the nodes are adjacent (as they nearly always are), so the only spans
+      //that hold one but not the other are those that start or end at n2 ...
+      AelSpan delta = n1->own;
+      AddSpan(delta, n2->own, -1);
+      n1->own = n2->own;
+      n2->own = delta;
+      AddSpan(n2->own, n1->own, 1);
+      for (int lvl = 0; lvl < n2->height; ++lvl) {
+        AddSpan(n2->span[lvl], delta, 1);
+        AddSpan(n2->prev[lvl]->span[lvl], delta, -1);
+      }
+    }
+    Update(e1);
+    Update(e2);
+  }
+  //------------------------------------------------------------------------------
+
+  void AelIndex::Prefix(const Active &e, AelSpan &result) const
+  {
+    //totals for all the edges to the left of e ...
+    ClearSpan(result);
+    const AelNode *n = e.ael_node;
+    while (n != &head) {
+      const AelNode *p = n->prev[n->height - 1];
+      AddSpan(result, p->span[n->height - 1], 1);
+      n = p;
+    }
+  }
+  //------------------------------------------------------------------------------
+
+  Active* AelIndex::FindPrev(const Active &e, int cnt_idx) const
+  {
+    //find the nearest edge to the left of e that's counted by cnt_idx ...
+    const AelNode *n = e.ael_node, *end = n;
+    int lvl = 0;
+    for (;;) {
+      if (n == &head) return NULL;
+      lvl = n->height - 1;
+      const AelNode *p = n->prev[lvl];
+      if (p->span[lvl].cnt[cnt_idx] > 0) { end = n; n = p; break; }
+      n = p;
+    }
+    //now descend into the last counted sub-span of [n, end) ...
+    for (; lvl > 0; --lvl) {
+      const AelNode *last = NULL;
+      for (const AelNode *p = n; p != end; p = p->next[lvl - 1])
+        if (p->span[lvl - 1].cnt[cnt_idx] > 0) last = p;
+      end = last->next[lvl - 1];
+      n = last;
+    }
+    return n->edge;
+  }
+  //------------------------------------------------------------------------------
+
+  Active* AelIndex::FindNext(const Active &e, int cnt_idx) const
+  {
+    //find the nearest edge to the right of e that's counted by cnt_idx ...
+    const AelNode *n = e.ael_node->next[0];
+    int lvl = 0;
+    for (;;) {
+      if (!n) return NULL;
+      lvl = n->height - 1;
+      if (n->span[lvl].cnt[cnt_idx] > 0) break;
+      n = n->next[lvl];
+    }
+    //now descend into the first counted sub-span ...
+    for (; lvl > 0; --lvl)
+      while (n->span[lvl - 1].cnt[cnt_idx] == 0) n = n->next[lvl - 1];
+    return n->edge;
+  }
+  //------------------------------------------------------------------------------
+
+  AelNode* AelIndex::FindInsertPos(const Active &e) const
+  {
+    //returns the rightmost node whose edge is strictly left of 'e', otherwise
+    //returns head. Edges with the same curr.x are left to the caller since
+    //E2InsertsBeforeE1() isn't monotonic across a run of them ...
+    const AelNode *p = &head;
+    for (int lvl = levels - 1; lvl >= 0; --lvl)
+      while (p->next[lvl] && p->next[lvl]->edge->curr.x < e.curr.x)
+        p = p->next[lvl];
+    return const_cast<AelNode*>(p);
   }
   //------------------------------------------------------------------------------
 
@@ -285,34 +787,42 @@ namespace clipperlib {
   }
   //------------------------------------------------------------------------------
 
-  Active *GetMaximaPair(const Active &e)
+  inline void JoinMaximaPair(Active &e)
   {
-    Active *e2;
-    if (IsHorizontal(e)) {
-      //we can't be sure whether the MaximaPair is on the left or right, so ...
-      e2 = e.prev_in_ael;
-      while (e2 && e2->curr.x >= e.top.x) {
-        if (e2->vertex_top == e.vertex_top) return e2;  //Found!
-        e2 = e2->prev_in_ael;
-      }
-      e2 = e.next_in_ael;
-      while (e2 && (TopX(*e2, e.top.y) <= e.top.x)) {
-        if (e2->vertex_top == e.vertex_top) return e2;  //Found!
-        e2 = e2->next_in_ael;
-      }
-      return NULL;
+    //called whenever e.vertex_top changes. The first bound to reach a local
+    //maxima waits in the vertex, and the second links the two together ...
+    Vertex *v = e.vertex_top;
+    if (!(v->flags & vfLocalMax)) return;
+    if (!v->max_e) 
+      v->max_e = &e;
+    else if (v->max_e != &e) {
+      e.max_pair = v->max_e;
+      v->max_e->max_pair = &e;
+      v->max_e = NULL;
     }
-    else {
-      e2 = e.next_in_ael;
-      while (e2) {
-        if (e2->vertex_top == e.vertex_top) return e2;  //Found!
-        e2 = e2->next_in_ael;
-      }
-      return NULL;
+  }
+  //------------------------------------------------------------------------------
+
+  inline void SplitMaximaPair(Active &e)
+  {
+    //called before e leaves either its vertex_top or the AEL ...
+    if (e.vertex_top->max_e == &e) e.vertex_top->max_e = NULL;
+    if (e.max_pair) {
+      e.max_pair->max_pair = NULL;
+      e.max_pair = NULL;
     }
   }
   //------------------------------------------------------------------------------
 
+  inline Active *GetMaximaPair(const Active &e)
+  {
+    //nb: when e isn't horizontal, a horizontal partner will always be to the
+    //left of e in the AEL and it's left for ProcessHorizontal() to find.
+    if (e.max_pair && !IsHorizontal(e) && IsHorizontal(*e.max_pair)) return NULL;
+    return e.max_pair;
+  }
+  //------------------------------------------------------------------------------
+
   inline int PointCount(OutPt *op)
   {
     if (!op) return 0;
@@ -326,18 +836,6 @@ namespace clipperlib {
   }
   //------------------------------------------------------------------------------
 
-  inline void DisposeOutPts(OutPt *&op)
-  {
-    if (!op) return;
-    op->prev->next = NULL;
-    while (op) {
-      OutPt *tmpPp = op;
-      op = op->next;
-      delete tmpPp;
-    }
-  }
-  //------------------------------------------------------------------------------
-
   bool IntersectListSort(IntersectNode *node1, IntersectNode *node2)
   {
     return (node2->pt.y < node1->pt.y);
@@ -382,50 +880,328 @@ namespace clipperlib {
   }
 
   //------------------------------------------------------------------------------
-  // Clipper class methods ...
+  // Pipelined Execute (see Clipper::PipelinedExecute) ...
+  //------------------------------------------------------------------------------
+
+  #define PIPE_MINIMA_BLOCK  (1024) //the first block of minima (then doubling)
+  #define PIPE_OUTREC_BATCH  (64)   //closed outrecs passed on at a time
+
+  //Pipeline: state shared by the sweep (the calling thread), the thread that
+  //sorts the local minima, and the thread that builds the solution's paths.
+  //(Only WorkerJob's error handling is used, not its 'next'.)
+  struct Pipeline : public WorkerJob {
+    std::mutex         mutex;
+    std::condition_variable minima_cv;
+    std::condition_variable outrec_cv;
+    std::thread        sorter;
+    std::atomic< bool > minima_done;
+    std::atomic< int64_t > minima_low_y; //every minima at or above is sorted
+    std::thread        builder;
+    std::vector< OutRec* > pending;      //closed outrecs (sweep only)
+    std::vector< OutRec* > closed;       //passed on to the builder
+    bool               sweep_done;
+    std::vector< std::pair< unsigned, Path > > paths; //built, with outrec idx
+    Pipeline() : minima_done(true), minima_low_y(INT64_MAX), sweep_done(false) {}
+  };
+
+  struct MinimaAtY {
+    int64_t y;
+    bool operator()(const LocalMinima *lm) const { return lm->vertex->pt.y == y; }
+  };
+
+  struct PathIdxLess {
+    bool operator()(const std::pair< unsigned, Path > &a, 
+      const std::pair< unsigned, Path > &b) const { return a.first < b.first; }
+  };
+
+  void MinimaSorter(Pipeline *pipe, MinimaList *minima)
+  {
+    //minima are sorted (highest first) a block at a time, and each block also
+    //takes any remaining minima at its lowest y, so the sweep can safely use a
+    //block as soon as it's sorted ...
+    try {
+      MinimaList::iterator first = minima->begin();
+      size_t block = PIPE_MINIMA_BLOCK;
+      while (first != minima->end()) {
+        MinimaList::iterator last = 
+          first + std::min(block, size_t(minima->end() - first));
+        if (last != minima->end()) {
+          std::nth_element(first, last - 1, minima->end(), LocMinSorter());
+          MinimaAtY at_y = { (*(last - 1))->vertex->pt.y };
+          last = std::partition(last, minima->end(), at_y);
+        }
+        std::sort(first, last, LocMinSorter());
+        first = last;
+        block *= 2;
+        std::lock_guard< std::mutex > lock(pipe->mutex);
+        pipe->minima_low_y = (*(last - 1))->vertex->pt.y;
+        if (first == minima->end()) pipe->minima_done = true;
+        pipe->minima_cv.notify_all();
+      }
+    }
+    catch (...) {
+      pipe->SetError();
+      std::lock_guard< std::mutex > lock(pipe->mutex);
+      pipe->minima_done = true;
+      pipe->minima_cv.notify_all();
+    }
+  }
+  //------------------------------------------------------------------------------
+
+  inline void WaitForMinima(Pipeline &pipe, int64_t y)
+  {
+    //the sweep at y reads the minima at y and the one after (below) them ...
+    if (pipe.minima_done || pipe.minima_low_y < y) return;
+    std::unique_lock< std::mutex > lock(pipe.mutex);
+    while (!pipe.minima_done && pipe.minima_low_y >= y) pipe.minima_cv.wait(lock);
+    if (pipe.failed) std::rethrow_exception(pipe.error);
+  }
   //------------------------------------------------------------------------------
 
-  Clipper::Clipper()
+  //BuildPath: copies the outrec's vertices into path unless there are too few
+  inline bool BuildPath(const OutRec &outrec, Path &path)
+  {
+    if (!outrec.pts) return false;
+    OutPt *op = outrec.pts->next;
+    int cnt = PointCount(op);
+    //fixup for duplicate start and end points ...
+    if (op->pt == outrec.pts->pt) cnt--;
+    if (cnt < 2 || (outrec.flag != orOpen && cnt == 2)) return false;
+    path.reserve(cnt);
+    for (int i = 0; i < cnt; i++) { path.push_back(op->pt); op = op->next; }
+    return true;
+  }
+  //------------------------------------------------------------------------------
+
+  inline void PassOnOutRecs(Pipeline &pipe, bool sweep_done)
+  {
+    std::lock_guard< std::mutex > lock(pipe.mutex);
+    pipe.closed.insert(pipe.closed.end(), pipe.pending.begin(), pipe.pending.end());
+    pipe.pending.resize(0);
+    if (sweep_done) pipe.sweep_done = true;
+    pipe.outrec_cv.notify_one();
+  }
+  //------------------------------------------------------------------------------
+
+  void OutRecBuilder(Pipeline *pipe)
+  {
+    //closed outrecs are never touched again by the sweep, so their paths are
+    //built while the sweep continues ...
+    std::vector< OutRec* > batch;
+    for (;;) {
+      {
+        std::unique_lock< std::mutex > lock(pipe->mutex);
+        while (pipe->closed.empty() && !pipe->sweep_done) pipe->outrec_cv.wait(lock);
+        if (pipe->closed.empty()) break;
+        batch.swap(pipe->closed);
+      }
+      try {
+        for (size_t i = 0; i < batch.size(); ++i) {
+          pipe->paths.push_back(std::make_pair(batch[i]->idx, Path()));
+          if (!BuildPath(*batch[i], pipe->paths.back().second)) pipe->paths.pop_back();
+        }
+      }
+      catch (...) {
+        pipe->SetError();
+      }
+      batch.resize(0);
+    }
+  }
+  //------------------------------------------------------------------------------
+
+  #define BUILD_CHUNK_SIZE (64)  //outrecs built at a time by each thread
+
+  //BuildJob: builds paths[i] for each outrec_list[i] (see BuildPathsInParallel)
+  struct BuildJob : public WorkerJob {
+    const OutRecList  *outrecs;
+    Paths             *paths;
+    bool               open_paths;
+  };
+
+  void PathsBuilder(WorkerJob *worker_job)
+  {
+    BuildJob *job = static_cast<BuildJob*>(worker_job);
+    for (;;) {
+      size_t chunk = job->next++;
+      size_t start = chunk * BUILD_CHUNK_SIZE;
+      if (start >= job->outrecs->size() || job->failed) break;
+      size_t end = std::min(start + BUILD_CHUNK_SIZE, job->outrecs->size());
+      for (size_t i = start; i < end; ++i) {
+        const OutRec &outrec = *(*job->outrecs)[i];
+        if (outrec.flag == orOpen && !job->open_paths) continue;
+        //nb: paths that are too small are left empty
+        if (!BuildPath(outrec, (*job->paths)[i])) (*job->paths)[i].clear();
+      }
+    }
+  }
+  //------------------------------------------------------------------------------
+
+  //------------------------------------------------------------------------------
+  // MemArena methods ...
+  //------------------------------------------------------------------------------
+
+  #define MEM_ARENA_BLOCK_SIZE (65536)
+
+  MemArena::MemArena(size_t chunk_size, MemoryResource *mr): 
+    blocks_(ResourceAllocator< char* >(mr)), pos_(NULL), end_(NULL), 
+    free_list_(NULL), mr_(mr ? mr : DefaultMemoryResource())
+  {
+    //round up so every chunk is suitably aligned for int64_t, double & pointers
+    const size_t align = sizeof(int64_t) > sizeof(void*) ? sizeof(int64_t) : sizeof(void*);
+    chunk_size_ = ((chunk_size + align - 1) / align) * align;
+    block_size_ = (MEM_ARENA_BLOCK_SIZE / chunk_size_) * chunk_size_;
+    if (block_size_ == 0) block_size_ = chunk_size_;
+  }
+  //------------------------------------------------------------------------------
+
+  MemArena::~MemArena()
   {
     Clear();
   }
+  //------------------------------------------------------------------------------
+
+  void *MemArena::Alloc()
+  {
+    if (free_list_) {
+      void *result = free_list_;
+      free_list_ = *static_cast<void**>(free_list_);
+      return result;
+    }
+    if (pos_ == end_) {
+      pos_ = static_cast<char*>(mr_->Allocate(block_size_));
+      end_ = pos_ + block_size_;
+      blocks_.push_back(pos_);
+    }
+    void *result = pos_;
+    pos_ += chunk_size_;
+    return result;
+  }
+  //------------------------------------------------------------------------------
+
+  void MemArena::Free(void *chunk)
+  {
+    *static_cast<void**>(chunk) = free_list_;
+    free_list_ = chunk;
+  }
+  //------------------------------------------------------------------------------
+
+  void MemArena::Clear()
+  {
+    for (size_t i = 0; i < blocks_.size(); ++i)
+      mr_->Deallocate(blocks_[i], block_size_);
+    blocks_.resize(0);
+    pos_ = NULL;
+    end_ = NULL;
+    free_list_ = NULL;
+  }
+  //------------------------------------------------------------------------------
+
+  //------------------------------------------------------------------------------
+  // Clipper class methods ...
+  //------------------------------------------------------------------------------
+
+  Clipper::Clipper(MemoryResource *mr) : mr_(mr ? mr : DefaultMemoryResource()),
+    actives_(NULL), sel_(NULL), minima_list_(ResourceAllocator< LocalMinima* >(mr_)),
+    outrec_list_(ResourceAllocator< OutRec* >(mr_)),
+    intersect_list_(ResourceAllocator< IntersectNode* >(mr_)),
+    vertex_list_(ResourceAllocator< Vertex* >(mr_)),
+    scanline_list_(ResourceAllocator< int64_t >(mr_)),
+    ael_index_(NULL), ael_width_(0), ael_index_off_(false),
+    par_min_width_(0), par_thread_cnt_(0), par_pool_(NULL), 
+    pipelined_(false), pipe_(NULL),
+    build_min_outrecs_(0), build_thread_cnt_(0),
+    outpt_arena_(sizeof(OutPt), mr_), active_arena_(sizeof(Active), mr_),
+    intersect_arena_(sizeof(IntersectNode), mr_), 
+    minima_arena_(sizeof(LocalMinima), mr_), outrec_arena_(sizeof(OutRec), mr_)
+  {
+    stop_requested_ = false;
+#ifdef use_xyz
+    zfill_func_ = NULL;
+#endif
+    Clear();
+  }
   //--------------------------- ---------------------------------------------------
 
   Clipper::~Clipper()
   {
+    DisposeAelIndex();
+    DisposeParPool();
     Clear();
   }
   //------------------------------------------------------------------------------
 
   void Clipper::CleanUp()
   {
+    //nb: the index goes first since, after an exception, it may be incomplete
+    DisposeAelIndex();
+    DisposeParPool();
     while (actives_) DeleteFromAEL(*actives_);
-    scanline_list_ = ScanlineList(); //resets priority_queue
+    active_arena_.Clear();
+    scanline_list_ = ScanlineList(ResourceAllocator< int64_t >(mr_)); //resets priority_queue
     DisposeAllOutRecs();
   }
   //------------------------------------------------------------------------------
 
+  void Clipper::ClearMaximaPairs()
+  {
+    //after an exception, a bound that never reached the AEL may still be
+    //waiting in its local maxima vertex (see JoinMaximaPair) ...
+    for (VerticesList::const_iterator i = vertex_list_.begin(); i != vertex_list_.end(); ++i) {
+      Vertex *v = *i;
+      do {
+        v->max_e = NULL;
+        v = v->next;
+      } while (v != *i);
+    }
+  }
+  //------------------------------------------------------------------------------
+
   void Clipper::Clear()
   {
     DisposeVerticesAndLocalMinima();
     curr_loc_min_ = minima_list_.begin();
-    minima_list_sorted_ = false;
+    minima_sorted_cnt_ = 0;
     has_open_paths_ = false;
+    path_cnt_ = 0;
   }
   //------------------------------------------------------------------------------
 
   void Clipper::Reset()
   {
-    if (!minima_list_sorted_) {
-      std::sort(minima_list_.begin(), minima_list_.end(), LocMinSorter());
-      minima_list_sorted_ = true;
+    //tidy up after any earlier Execute that didn't finish (eg it threw) ...
+    if (actives_ || !outrec_list_.empty()) {
+      CleanUp();
+      ClearMaximaPairs();
     }
     for (MinimaList::const_iterator i = minima_list_.begin(); i != minima_list_.end(); ++i)
       InsertScanline((*i)->vertex->pt.y);
+    if (minima_sorted_cnt_ < minima_list_.size()) {
+      bool sorting = false;
+      if (pipe_) {
+        //the sweep waits for each sorted block of minima (see WaitForMinima)
+        pipe_->minima_done = false;
+        try {
+          pipe_->sorter = std::thread(MinimaSorter, pipe_, &minima_list_);
+          sorting = true;
+        }
+        catch (const std::system_error&) {
+          pipe_->minima_done = true; //so they're sorted below instead
+        }
+      }
+      if (!sorting) {
+        //only sort minima added since the last sort (eg after LoadPrepared) ...
+        MinimaList::iterator mid = minima_list_.begin() + minima_sorted_cnt_;
+        std::sort(mid, minima_list_.end(), LocMinSorter());
+        std::inplace_merge(minima_list_.begin(), mid, minima_list_.end(), LocMinSorter());
+      }
+      minima_sorted_cnt_ = minima_list_.size();
+    }
     curr_loc_min_ = minima_list_.begin();
 
-    actives_ = NULL;
+    ael_width_ = 0;
+    ael_index_off_ = false;
     sel_ = NULL;
+    stop_requested_ = false;
   }
   //------------------------------------------------------------------------------
 
@@ -454,126 +1230,150 @@ namespace clipperlib {
 
   void Clipper::DisposeAllOutRecs()
   {
-    for (OutRecList::const_iterator i = outrec_list_.begin(); i != outrec_list_.end(); ++i) {
-      if ((*i)->pts) DisposeOutPts((*i)->pts);
-      delete (*i);
-    }
+    //OutRecs and OutPts all live in arenas so they needn't be disposed 
+    //individually (and descendant classes clear their own arenas) ...
     outrec_list_.resize(0);
+    outrec_arena_.Clear();
+    outpt_arena_.Clear();
+  }
+  //------------------------------------------------------------------------------
+
+  Vertex* Clipper::NewVertices(size_t cnt)
+  {
+    //the array is preceded by a spare vertex that holds its length ...
+    Vertex *result = static_cast<Vertex*>(mr_->Allocate((cnt + 1) * sizeof(Vertex)));
+    *reinterpret_cast<size_t*>(result) = cnt;
+    ++result;
+    for (size_t i = 0; i < cnt; ++i) new (&result[i]) Vertex;
+    return result;
   }
   //------------------------------------------------------------------------------
 
   void Clipper::DisposeVerticesAndLocalMinima()
   {
-    for (MinimaList::iterator ml_iter = minima_list_.begin(); 
-      ml_iter != minima_list_.end(); ++ml_iter)
-        delete (*ml_iter);
     minima_list_.clear();
+    minima_arena_.Clear();
     VerticesList::iterator vl_iter;
-    for (vl_iter = vertex_list_.begin(); vl_iter != vertex_list_.end(); ++vl_iter)
-      delete[] (*vl_iter);
+    for (vl_iter = vertex_list_.begin(); vl_iter != vertex_list_.end(); ++vl_iter) {
+      Vertex *vertices = (*vl_iter) - 1;
+      size_t cnt = *reinterpret_cast<size_t*>(vertices);
+      mr_->Deallocate(vertices, (cnt + 1) * sizeof(Vertex));
+    }
     vertex_list_.clear();
   }
   //------------------------------------------------------------------------------
 
-  void Clipper::AddLocMin(Vertex &vert, PathType polytype, bool is_open) 
+  void Clipper::AddLocMin(Vertex &vert, PathType polytype, bool is_open, bool flag_only) 
   {
     //make sure the vertex is added only once ...
     if (vfLocMin & vert.flags) return;
     vert.flags |= vfLocMin;
+    if (flag_only) return;
 
-    LocalMinima *lm = new LocalMinima();
+    LocalMinima *lm = new (minima_arena_.Alloc()) LocalMinima();
     lm->vertex = &vert;
     lm->polytype = polytype;
     lm->is_open = is_open;
+    lm->path_id = path_cnt_;
     minima_list_.push_back(lm);
   }
   //----------------------------------------------------------------------------
 
-  void Clipper::AddPathToVertexList(const Path &path, PathType polytype, bool is_open) 
+  bool Clipper::SetVertexFlags(Vertex *first, PathType polytype, bool is_open, 
+    bool flag_only)
   {
-    int path_len = int(path.size());
-    while (path_len > 1 && (path[path_len - 1] == path[0])) --path_len;
-    if (path_len < 2) return;
+    //nb: the path's vertices are already linked (without duplicates)
+    Vertex *last = first->prev, *v = first;
+    do { v->flags = vfNone; v = v->next; } while (v != first);
 
-    int i = 1;
-    bool p0_is_minima = false, p0_is_maxima = false, going_up;
+    bool p0_is_minima = false, p0_is_maxima = false, going_up = false;
     //find the first non-horizontal segment in the path ...
-    while ((i < path_len) && (path[i].y == path[0].y)) ++i;
-    bool is_flat = (i == path_len);
-    if (is_flat) {
-      if (!is_open) return;    //Ignore closed paths that have ZERO area.
-      going_up = false;           //And this just stops a compiler warning.
+    v = first->next;
+    while (v != first && v->pt.y == first->pt.y) v = v->next;
+    if (v == first) {
+      if (!is_open) return false; //closed paths with ZERO area are ignored
     }
     else 
     {
-      going_up = path[i].y < path[0].y; //because I'm using an inverted Y-axis display
-      if (going_up) {
-        i = path_len - 1;
-        while (path[i].y == path[0].y) --i;
-        p0_is_minima = path[i].y < path[0].y; //p[0].y == a minima
-      }
-      else {
-        i = path_len - 1;
-        while (path[i].y == path[0].y) --i;
-        p0_is_maxima = path[i].y > path[0].y; //p[0].y == a maxima
-      }
+      going_up = v->pt.y < first->pt.y; //because I'm using an inverted Y-axis display
+      v = last;
+      while (v->pt.y == first->pt.y) v = v->prev;
+      if (going_up) 
+        p0_is_minima = v->pt.y < first->pt.y; //p[0].y == a minima
+      else
+        p0_is_maxima = v->pt.y > first->pt.y; //p[0].y == a maxima
     }
 
-    Vertex *vertices = new Vertex [path_len];
-    vertex_list_.push_back(vertices);
-
-    vertices[0].pt = path[0];
-    vertices[0].flags = vfNone;
-
     if (is_open) {
-      vertices[0].flags |= vfOpenStart;
-      if (going_up) AddLocMin(vertices[0], polytype, is_open); 
-      else vertices[0].flags |= vfLocalMax;
+      first->flags |= vfOpenStart;
+      if (going_up) AddLocMin(*first, polytype, is_open, flag_only);
+      else first->flags |= vfLocalMax;
     }
 
     //nb: polygon orientation is determined later (see InsertLocalMinimaIntoAEL).
-    i = 0;
-    for (int j = 1; j < path_len; ++j) {
-      if (path[j] == vertices[i].pt) continue; //ie skips duplicates
-      vertices[j].pt = path[j];
-      vertices[j].flags = vfNone;
-      vertices[i].next = &vertices[j];
-      vertices[j].prev = &vertices[i];
-      if (path[j].y > path[i].y && going_up) {
-        vertices[i].flags |= vfLocalMax;
+    for (v = first; v != last; v = v->next) {
+      if (v->next->pt.y > v->pt.y && going_up) {
+        v->flags |= vfLocalMax;
         going_up = false;
       }
-      else if (path[j].y < path[i].y && !going_up) {
+      else if (v->next->pt.y < v->pt.y && !going_up) {
         going_up = true;
-        AddLocMin(vertices[i], polytype, is_open);
+        AddLocMin(*v, polytype, is_open, flag_only);
       }
-      i = j;
     }
-    //i: index of the last vertex in the path.
-    vertices[i].next = &vertices[0];
-    vertices[0].prev = &vertices[i];
 
     if (is_open) {    
-      vertices[i].flags |= vfOpenEnd;
-      if (going_up)
-        vertices[i].flags |= vfLocalMax;
-      else AddLocMin(vertices[i], polytype, is_open);
+      last->flags |= vfOpenEnd;
+      if (going_up) last->flags |= vfLocalMax;
+      else AddLocMin(*last, polytype, is_open, flag_only);
     }
     else if (going_up) {
       //going up so find local maxima ...
-      Vertex *v = &vertices[i];
+      v = last;
       while (v->next->pt.y <= v->pt.y) v = v->next;
       v->flags |= vfLocalMax;
-      if (p0_is_minima) AddLocMin(vertices[0], polytype, is_open);
+      if (p0_is_minima) AddLocMin(*first, polytype, is_open, flag_only);
     }
     else {
       //going down so find local minima ...
-      Vertex *v = &vertices[i];
+      v = last;
       while (v->next->pt.y >= v->pt.y) v = v->next;
-      AddLocMin(*v, polytype, is_open);
+      AddLocMin(*v, polytype, is_open, flag_only);
       if (p0_is_maxima)
-        vertices[0].flags |= vfLocalMax;
+        first->flags |= vfLocalMax;
+    }
+    return true;
+  }
+  //------------------------------------------------------------------------------
+
+  void Clipper::AddPathToVertexList(const Path &path, PathType polytype, bool is_open) 
+  {
+    int path_len = int(path.size());
+    while (path_len > 1 && (path[path_len - 1] == path[0])) --path_len;
+    if (path_len < 2) return;
+
+    int i = 1;
+    while ((i < path_len) && (path[i].y == path[0].y)) ++i;
+    if (i == path_len && !is_open) return; //Ignore closed paths that have ZERO area.
+
+    Vertex *vertices = NewVertices(path_len);
+    vertex_list_.push_back(vertices);
+
+    //link the vertices, skipping duplicates ...
+    int cnt = 0;
+    for (int j = 0; j < path_len; ++j) {
+      if (cnt && path[j] == vertices[cnt - 1].pt) continue;
+      vertices[cnt].pt = path[j];
+      vertices[cnt].max_e = NULL;
+      if (cnt) {
+        vertices[cnt - 1].next = &vertices[cnt];
+        vertices[cnt].prev = &vertices[cnt - 1];
+      }
+      ++cnt;
     }
+    vertices[cnt - 1].next = &vertices[0];
+    vertices[0].prev = &vertices[cnt - 1];
+    SetVertexFlags(vertices, polytype, is_open, false);
   }
   //------------------------------------------------------------------------------
 
@@ -584,8 +1384,8 @@ namespace clipperlib {
         throw ClipperException("AddPath: Only subject paths may be open.");
       has_open_paths_ = true;
     }
-    minima_list_sorted_ = false;
     AddPathToVertexList(path, polytype, is_open);
+    path_cnt_++;
   }
   //------------------------------------------------------------------------------
 
@@ -596,6 +1396,260 @@ namespace clipperlib {
   }
   //------------------------------------------------------------------------------
 
+  //------------------------------------------------------------------------------
+  // Prepared blobs (see SavePrepared) ...
+  //------------------------------------------------------------------------------
+
+  //The blob is a PreparedHeader, then ring_cnt vertex counts (int64_t), then
+  //the vertices of every ring (PreparedVertex), each ring in 'next' order, and
+  //finally the local minima (PreparedMinima) in their sorted order. Vertices
+  //are referenced by ring and offset rather than by address, so the blob can
+  //be loaded from anywhere (eg a memory mapped file).
+
+  #define PREPARED_VERSION (1)
+
+  struct PreparedHeader {
+    char         magic[4];       //"CLPP"
+    uint32_t     version;
+    uint32_t     point_size;     //sizeof(Point64) (which depends on use_xyz)
+    uint32_t     has_open_paths;
+    int64_t      path_cnt;
+    int64_t      ring_cnt;
+    int64_t      vertex_cnt;
+    int64_t      minima_cnt;
+  };
+
+  struct PreparedVertex {
+    Point64      pt;
+    int64_t      flags;
+  };
+
+  struct PreparedMinima {
+    int64_t      ring;
+    int64_t      offset;         //the vertex's position in its ring
+    int32_t      path_id;
+    int32_t      polytype;
+    int64_t      is_open;
+  };
+
+  struct RingPos {
+    const Vertex *vertex;
+    int64_t      ring;
+    int64_t      offset;
+  };
+
+  inline bool RingPosLess(const RingPos &a, const RingPos &b) { return a.vertex < b.vertex; }
+  //------------------------------------------------------------------------------
+
+  template <typename T>
+  inline void WriteBlob(char *&dst, const T &val)
+  {
+    memcpy(dst, &val, sizeof(T));
+    dst += sizeof(T);
+  }
+  //------------------------------------------------------------------------------
+
+  template <typename T>
+  inline void ReadBlob(const char *&src, T &val)
+  {
+    memcpy(&val, src, sizeof(T));
+    src += sizeof(T);
+  }
+  //------------------------------------------------------------------------------
+
+  void Clipper::SavePrepared(std::vector< char > &blob)
+  {
+    if (minima_sorted_cnt_ < minima_list_.size()) {
+      std::sort(minima_list_.begin(), minima_list_.end(), LocMinSorter());
+      minima_sorted_cnt_ = minima_list_.size();
+    }
+
+    //count each ring's vertices by walking it (a ring's array may be longer
+    //when duplicates were skipped), and note where the local minima are so 
+    //they can be found by ring and offset ...
+    std::vector< int64_t > ring_lens;
+    std::vector< RingPos > minima_pos;
+    ring_lens.reserve(vertex_list_.size());
+    minima_pos.reserve(minima_list_.size());
+    int64_t vertex_cnt = 0;
+    for (size_t i = 0; i < vertex_list_.size(); ++i) {
+      Vertex *v = vertex_list_[i];
+      int64_t cnt = 0;
+      do {
+        if (v->flags & vfLocMin) {
+          RingPos rp = { v, int64_t(i), cnt };
+          minima_pos.push_back(rp);
+        }
+        ++cnt;
+        v = v->next;
+      } while (v != vertex_list_[i]);
+      ring_lens.push_back(cnt);
+      vertex_cnt += cnt;
+    }
+    std::sort(minima_pos.begin(), minima_pos.end(), RingPosLess);
+
+    PreparedHeader hdr;
+    memcpy(hdr.magic, "CLPP", 4);
+    hdr.version = PREPARED_VERSION;
+    hdr.point_size = sizeof(Point64);
+    hdr.has_open_paths = has_open_paths_;
+    hdr.path_cnt = path_cnt_;
+    hdr.ring_cnt = int64_t(ring_lens.size());
+    hdr.vertex_cnt = vertex_cnt;
+    hdr.minima_cnt = int64_t(minima_list_.size());
+
+    blob.resize(sizeof(PreparedHeader) + ring_lens.size() * sizeof(int64_t) +
+      vertex_cnt * sizeof(PreparedVertex) + minima_list_.size() * sizeof(PreparedMinima));
+    char *dst = blob.empty() ? NULL : &blob[0];
+    WriteBlob(dst, hdr);
+    for (size_t i = 0; i < ring_lens.size(); ++i) WriteBlob(dst, ring_lens[i]);
+    for (size_t i = 0; i < vertex_list_.size(); ++i) {
+      Vertex *v = vertex_list_[i];
+      do {
+        PreparedVertex pv;
+        pv.pt = v->pt;
+        pv.flags = v->flags;
+        WriteBlob(dst, pv);
+        v = v->next;
+      } while (v != vertex_list_[i]);
+    }
+    for (MinimaList::const_iterator ml_iter = minima_list_.begin();
+      ml_iter != minima_list_.end(); ++ml_iter)
+    {
+      RingPos key = { (*ml_iter)->vertex, 0, 0 };
+      std::vector< RingPos >::const_iterator rp = 
+        std::lower_bound(minima_pos.begin(), minima_pos.end(), key, RingPosLess);
+      PreparedMinima pm;
+      pm.ring = rp->ring;
+      pm.offset = rp->offset;
+      pm.path_id = (*ml_iter)->path_id;
+      pm.polytype = (*ml_iter)->polytype;
+      pm.is_open = (*ml_iter)->is_open;
+      WriteBlob(dst, pm);
+    }
+  }
+  //------------------------------------------------------------------------------
+
+  void Clipper::LoadPrepared(const char *blob, size_t size)
+  {
+    Clear();
+    PreparedHeader hdr;
+    if (size < sizeof(hdr))
+      throw ClipperException("LoadPrepared: invalid blob.");
+    const char *src = blob;
+    ReadBlob(src, hdr);
+    if (memcmp(hdr.magic, "CLPP", 4) != 0 || hdr.version != PREPARED_VERSION ||
+      hdr.point_size != sizeof(Point64) || hdr.ring_cnt < 0 || 
+      hdr.vertex_cnt < 0 || hdr.minima_cnt < 0 || hdr.path_cnt < 0 ||
+      hdr.path_cnt > std::numeric_limits<int>::max() ||
+      uint64_t(hdr.ring_cnt) > (size - sizeof(hdr)) / sizeof(int64_t) ||
+      uint64_t(hdr.vertex_cnt) > size / sizeof(PreparedVertex) ||
+      uint64_t(hdr.minima_cnt) > size / sizeof(PreparedMinima) ||
+      size != sizeof(hdr) + hdr.ring_cnt * sizeof(int64_t) +
+        hdr.vertex_cnt * sizeof(PreparedVertex) + 
+        hdr.minima_cnt * sizeof(PreparedMinima))
+          throw ClipperException("LoadPrepared: invalid blob.");
+
+    std::vector< int64_t > ring_lens(size_t(hdr.ring_cnt));
+    int64_t vertex_cnt = 0;
+    for (size_t i = 0; i < ring_lens.size(); ++i) {
+      ReadBlob(src, ring_lens[i]);
+      if (ring_lens[i] < 1 || ring_lens[i] > hdr.vertex_cnt - vertex_cnt) {
+        Clear();
+        throw ClipperException("LoadPrepared: invalid blob.");
+      }
+      vertex_cnt += ring_lens[i];
+    }
+
+    //rebuild each ring in one array, linking its vertices in order, then 
+    //make sure that its flags are those that AddPath would have given it ...
+    std::vector< int64_t > ring_starts(ring_lens.size());
+    std::vector< int64_t > saved_flags;
+    int64_t locmin_cnt = 0;
+    vertex_list_.reserve(ring_lens.size());
+    for (size_t i = 0; i < ring_lens.size(); ++i) {
+      size_t cnt = size_t(ring_lens[i]);
+      ring_starts[i] = (i ? ring_starts[i - 1] + ring_lens[i - 1] : 0);
+      Vertex *vertices = NewVertices(cnt);
+      vertex_list_.push_back(vertices);
+      saved_flags.resize(cnt);
+      bool is_valid = (cnt > 1);
+      for (size_t j = 0; j < cnt; ++j) {
+        PreparedVertex pv;
+        ReadBlob(src, pv);
+        saved_flags[j] = pv.flags;
+        vertices[j].pt = pv.pt;
+        vertices[j].flags = vfNone;
+        vertices[j].max_e = NULL;
+        vertices[j].next = &vertices[j + 1 < cnt ? j + 1 : 0];
+        vertices[j].prev = &vertices[j > 0 ? j - 1 : cnt - 1];
+        if (j && pv.pt == vertices[j - 1].pt) is_valid = false; //a duplicate
+      }
+      if (is_valid) is_valid = vertices[cnt - 1].pt != vertices[0].pt &&
+        SetVertexFlags(vertices, ptSubject, (saved_flags[0] & vfOpenStart) != 0, true);
+      for (size_t j = 0; is_valid && j < cnt; ++j) {
+        if (vertices[j].flags != saved_flags[j]) is_valid = false;
+        else if (vertices[j].flags & vfLocMin) ++locmin_cnt;
+      }
+      if (!is_valid) {
+        Clear();
+        throw ClipperException("LoadPrepared: invalid blob.");
+      }
+    }
+
+    //the minima were saved sorted, so Reset needn't sort them again (but each
+    //vertex flagged vfLocMin must have exactly one, and a ring's minima must 
+    //all come from the same path) ...
+    std::vector< bool > is_used(size_t(hdr.vertex_cnt));
+    std::vector< LocalMinima* > ring_minima(ring_lens.size());
+    minima_list_.reserve(size_t(hdr.minima_cnt));
+    for (int64_t i = 0; i < hdr.minima_cnt; ++i) {
+      PreparedMinima pm;
+      ReadBlob(src, pm);
+      bool is_valid = pm.ring >= 0 && pm.ring < hdr.ring_cnt && 
+        pm.offset >= 0 && pm.offset < ring_lens[size_t(pm.ring)] &&
+        (pm.polytype == ptSubject || pm.polytype == ptClip) &&
+        pm.path_id >= 0 && pm.path_id < hdr.path_cnt &&
+        (pm.is_open == 0 || (hdr.has_open_paths != 0 && pm.polytype == ptSubject));
+      Vertex *v = NULL;
+      if (is_valid) {
+        size_t ring = size_t(pm.ring), pos = size_t(ring_starts[ring] + pm.offset);
+        v = &vertex_list_[ring][size_t(pm.offset)];
+        LocalMinima *first = ring_minima[ring];
+        is_valid = (v->flags & vfLocMin) && !is_used[pos] &&
+          (pm.is_open != 0) == ((vertex_list_[ring]->flags & vfOpenStart) != 0) &&
+          (!first || (first->path_id == pm.path_id && first->polytype == pm.polytype)) &&
+          (minima_list_.empty() || v->pt.y <= minima_list_.back()->vertex->pt.y);
+        is_used[pos] = true;
+      }
+      if (!is_valid) {
+        Clear();
+        throw ClipperException("LoadPrepared: invalid blob.");
+      }
+      LocalMinima *lm = new (minima_arena_.Alloc()) LocalMinima();
+      lm->vertex = v;
+      lm->polytype = static_cast<PathType>(pm.polytype);
+      lm->is_open = (pm.is_open != 0);
+      lm->path_id = pm.path_id;
+      minima_list_.push_back(lm);
+      if (!ring_minima[size_t(pm.ring)]) ring_minima[size_t(pm.ring)] = lm;
+    }
+    if (hdr.minima_cnt != locmin_cnt) {
+      Clear();
+      throw ClipperException("LoadPrepared: invalid blob.");
+    }
+    minima_sorted_cnt_ = minima_list_.size();
+    curr_loc_min_ = minima_list_.begin();
+    has_open_paths_ = (hdr.has_open_paths != 0);
+    path_cnt_ = int(hdr.path_cnt);
+  }
+  //------------------------------------------------------------------------------
+
+  //nb: these switches (and those in IntersectEdges) are loop invariant, so
+  //they're well predicted. Instantiating the sweep's steps for each ClipType
+  //and FillRule instead (chosen once per Execute) measured no faster, and it
+  //added about 50KB of code.
+
   bool Clipper::IsContributingClosed(const Active& e) const
   {
     switch (fillrule_) {
@@ -671,7 +1725,8 @@ namespace clipperlib {
     Active *e2 = e.prev_in_ael;
     //find the nearest closed path edge of the same PolyType in AEL (heading left)
     PathType pt = GetPolyType(e);
-    while (e2 && (GetPolyType(*e2) != pt || IsOpen(*e2))) e2 = e2->prev_in_ael;
+    if (ael_index_) e2 = ael_index_->FindPrev(e, pt);
+    else while (e2 && (GetPolyType(*e2) != pt || IsOpen(*e2))) e2 = e2->prev_in_ael;
 
     if (!e2) {
       e.wind_cnt = e.wind_dx;
@@ -716,7 +1771,17 @@ namespace clipperlib {
     }
 
     //update wind_cnt2 ...
-    if (fillrule_ == frEvenOdd)
+    if (ael_index_) {
+      //totals for the edges from e2 up to e ...
+      AelSpan s, s2;
+      ael_index_->Prefix(e, s);
+      ael_index_->Prefix(*e2, s2);
+      AddSpan(s, s2, -1);
+      PathType pt2 = (pt == ptSubject ? ptClip : ptSubject);
+      if (fillrule_ != frEvenOdd) e.wind_cnt2 += s.wind[pt2];
+      else if (IsOdd(s.cnt[pt2])) e.wind_cnt2 = (e.wind_cnt2 == 0 ? 1 : 0);
+    }
+    else if (fillrule_ == frEvenOdd)
       while (e2 != &e) {
         if (GetPolyType(*e2) != pt && !IsOpen(*e2))
           e.wind_cnt2 = (e.wind_cnt2 == 0 ? 1 : 0);
@@ -734,7 +1799,19 @@ namespace clipperlib {
   void Clipper::SetWindingLeftEdgeOpen(Active &e)
   {
     Active *e2 = actives_;
-    if (fillrule_ == frEvenOdd) {
+    if (ael_index_) {
+      AelSpan s;
+      ael_index_->Prefix(e, s);
+      if (fillrule_ == frEvenOdd) {
+        e.wind_cnt = (IsOdd(s.cnt[ptSubject]) ? 1 : 0);
+        e.wind_cnt2 = (IsOdd(s.cnt[ptClip]) ? 1 : 0);
+      }
+      else {
+        e.wind_cnt += s.wind[ptSubject];
+        e.wind_cnt2 += s.wind[ptClip];
+      }
+    }
+    else if (fillrule_ == frEvenOdd) {
       int cnt1 = 0, cnt2 = 0;
       while (e2 != &e) {
         if (GetPolyType(*e2) == ptClip) cnt2++;
@@ -754,12 +1831,66 @@ namespace clipperlib {
   }
   //------------------------------------------------------------------------------
 
+  void Clipper::BuildAelIndex()
+  {
+    ael_index_ = new (mr_->Allocate(sizeof(AelIndex))) AelIndex(mr_);
+    AelNode *last[AEL_INDEX_MAX_LEVEL];
+    for (int lvl = 0; lvl < AEL_INDEX_MAX_LEVEL; ++lvl) last[lvl] = &ael_index_->head;
+    for (Active *e = actives_; e; e = e->next_in_ael) {
+      AelNode *n = ael_index_->NewNode(*e);
+      n->span[0] = n->own;
+      for (int lvl = 0; lvl < n->height; ++lvl) {
+        n->next[lvl] = NULL;
+        n->prev[lvl] = last[lvl];
+        last[lvl]->next[lvl] = n;
+        last[lvl] = n;
+      }
+    }
+    //now total the spans of each level from those of the level below ...
+    for (int lvl = 1; lvl < AEL_INDEX_MAX_LEVEL; ++lvl)
+      for (AelNode *n = &ael_index_->head; n; n = n->next[lvl]) {
+        ClearSpan(n->span[lvl]);
+        for (AelNode *n2 = n; n2 != n->next[lvl]; n2 = n2->next[lvl - 1])
+          AddSpan(n->span[lvl], n2->span[lvl - 1], 1);
+      }
+  }
+  //------------------------------------------------------------------------------
+
+  inline void Clipper::UpdateAelIndex(Active &e1, Active &e2)
+  {
+    //nb: this must follow any change to whether or not an edge is 'hot'
+    if (!ael_index_) return;
+    ael_index_->Update(e1);
+    ael_index_->Update(e2);
+  }
+  //------------------------------------------------------------------------------
+
+  void Clipper::DisposeAelIndex()
+  {
+    if (!ael_index_) return;
+    ael_index_->~AelIndex();
+    mr_->Deallocate(ael_index_, sizeof(AelIndex));
+    ael_index_ = NULL;
+  }
+  //------------------------------------------------------------------------------
+
+  void Clipper::DisposeParPool()
+  {
+    if (!par_pool_) return;
+    par_pool_->~WorkerPool();
+    mr_->Deallocate(par_pool_, sizeof(WorkerPool));
+    par_pool_ = NULL;
+  }
+  //------------------------------------------------------------------------------
+
   void Clipper::InsertEdgeIntoAEL(Active &e1, Active *e2)
   {
+    ++ael_width_;
     if (!actives_) {
       e1.prev_in_ael = NULL;
       e1.next_in_ael = NULL;
       actives_ = &e1;
+      if (ael_index_) ael_index_->InsertAfter(&ael_index_->head, e1);
       return;
     }
     if (!e2) {
@@ -768,9 +1899,16 @@ namespace clipperlib {
         e1.next_in_ael = actives_;
         actives_->prev_in_ael = &e1;
         actives_ = &e1;
+        if (ael_index_) ael_index_->InsertAfter(&ael_index_->head, e1);
         return;
       }
       e2 = actives_;
+      if (ael_index_) {
+        //skip most of the linear search below ...
+        AelNode *n = ael_index_->FindInsertPos(e1);
+        if (n != &ael_index_->head) e2 = n->edge;
+        ael_index_->saved += ael_width_;
+      }
       while (e2->next_in_ael &&
         E2InsertsBeforeE1(e1, *e2->next_in_ael, false))
         e2 = e2->next_in_ael;
@@ -784,6 +1922,8 @@ namespace clipperlib {
     if (e2->next_in_ael) e2->next_in_ael->prev_in_ael = &e1;
     e1.prev_in_ael = e2;
     e2->next_in_ael = &e1;
+    if (ael_index_) ael_index_->InsertAfter(e2->ael_node, e1);
+    else if (ael_width_ > AEL_INDEX_MIN_WIDTH && !ael_index_off_) BuildAelIndex();
   }
   //----------------------------------------------------------------------
 
@@ -797,28 +1937,36 @@ namespace clipperlib {
         left_bound = NULL;
       }
       else {
-        left_bound = new Active();
+        left_bound = new (active_arena_.Alloc()) Active();
         left_bound->bot = local_minima->vertex->pt;
         left_bound->curr = left_bound->bot;
         left_bound->vertex_top = local_minima->vertex->prev; //ie descending
         left_bound->top = left_bound->vertex_top->pt;
         left_bound->wind_dx = -1;
         left_bound->local_min = local_minima;
+        left_bound->polytype = local_minima->polytype;
+        left_bound->is_open = local_minima->is_open;
+        left_bound->path_id = local_minima->path_id;
         SetDx(*left_bound);
+        JoinMaximaPair(*left_bound);
       }
 
       if ((local_minima->vertex->flags & vfOpenEnd) > 0) {
         right_bound = NULL;
       }
       else {
-        right_bound = new Active();
+        right_bound = new (active_arena_.Alloc()) Active();
         right_bound->bot = local_minima->vertex->pt;
         right_bound->curr = right_bound->bot;
         right_bound->vertex_top = local_minima->vertex->next; //ie ascending
         right_bound->top = right_bound->vertex_top->pt;
         right_bound->wind_dx = 1;
         right_bound->local_min = local_minima;
+        right_bound->polytype = local_minima->polytype;
+        right_bound->is_open = local_minima->is_open;
+        right_bound->path_id = local_minima->path_id;
         SetDx(*right_bound);
+        JoinMaximaPair(*right_bound);
       }
 
       //Currently LeftB is just the descending bound and RightB is the ascending.
@@ -867,6 +2015,7 @@ namespace clipperlib {
         //intersect edges that are between left and right bounds ...
         Active *e = right_bound->next_in_ael;
         MoveEdgeToFollowLeftInAEL(*right_bound, *left_bound);
+        if (ael_index_) ael_index_->MoveAfter(*right_bound, *left_bound);
         while (right_bound->next_in_ael != e) {
           //nb: For calculating winding counts etc, IntersectEdges() assumes
           //that rightB will be to the right of e ABOVE the intersection ...
@@ -898,17 +2047,23 @@ namespace clipperlib {
   OutRec* Clipper::GetOwner(const Active *e)
   {
     if (IsHorizontal(*e) && e->top.x < e->bot.x) {
-      e = e->next_in_ael;
-      while (e && (!IsHotEdge(*e) || IsOpen(*e)))
+      if (ael_index_) e = ael_index_->FindNext(*e, AEL_HOT_CNT);
+      else {
         e = e->next_in_ael;
+        while (e && (!IsHotEdge(*e) || IsOpen(*e)))
+          e = e->next_in_ael;
+      }
       if (!e) return NULL;
       return ((e->outrec->flag == orOuter) == (e->outrec->start_e == e)) ?
         e->outrec->owner : e->outrec;
     }
     else {
-      e = e->prev_in_ael;
-      while (e && (!IsHotEdge(*e) || IsOpen(*e))) 
+      if (ael_index_) e = ael_index_->FindPrev(*e, AEL_HOT_CNT);
+      else {
         e = e->prev_in_ael;
+        while (e && (!IsHotEdge(*e) || IsOpen(*e))) 
+          e = e->prev_in_ael;
+      }
       if (!e) return NULL;
       return ((e->outrec->flag == orOuter) == (e->outrec->end_e == e)) ?
         e->outrec->owner : e->outrec;
@@ -944,6 +2099,7 @@ namespace clipperlib {
       SetOrientation(*outrec, e1, e2); 
     else 
       SetOrientation(*outrec, e2, e1);
+    UpdateAelIndex(e1, e2);
 
     OutPt *op = CreateOutPt();
     op->pt = pt;
@@ -959,10 +2115,16 @@ namespace clipperlib {
       throw new ClipperException("Error in AddLocalMaxPoly().");
     AddOutPt(e1, pt);
     if (e1.outrec == e2.outrec) {
+      if (pipe_) {
+        //this closed path is now complete, so it can go to the builder ...
+        pipe_->pending.push_back(e1.outrec);
+        if (pipe_->pending.size() >= PIPE_OUTREC_BATCH) PassOnOutRecs(*pipe_, false);
+      }
       e1.outrec->start_e = NULL;
       e1.outrec->end_e = NULL;
       e1.outrec = NULL;
       e2.outrec = NULL;
+      UpdateAelIndex(e1, e2);
     }
     //and to preserve the winding orientation of outrec ...
     else if (e1.outrec->idx < e2.outrec->idx)
@@ -971,6 +2133,39 @@ namespace clipperlib {
   }
   //------------------------------------------------------------------------------
 
+  bool Clipper::IsLeftBound(const Active &e) const
+  {
+    //ie there's an even number of closed hot edges to the left of e
+    bool result = true;
+    if (ael_index_) {
+      AelSpan s;
+      ael_index_->Prefix(e, s);
+      result = !IsOdd(s.cnt[AEL_HOT_CNT]);
+    }
+    else {
+      const Active* e2 = &e;
+      while (e2->prev_in_ael) {
+        e2 = e2->prev_in_ael;
+        if (e2->outrec && !IsOpen(*e2)) result = !result;
+      }
+    }
+    return result;
+  }
+  //------------------------------------------------------------------------------
+
+  bool Clipper::FixOrientation(Active &e)
+  {
+    bool result = IsLeftBound(e);
+    if (result != IsStartSide(e)) {
+      if (result) e.outrec->flag = orOuter;
+      else e.outrec->flag = orInner;
+      ReverseSides(*e.outrec);
+      return true; //all fixed
+    }
+    else return false; //no fix needed
+  }
+  //------------------------------------------------------------------------------
+
   void Clipper::JoinOutrecPaths(Active &e1, Active &e2)
   {
 
@@ -1017,6 +2212,7 @@ namespace clipperlib {
     //and e1 and e2 are maxima and are about to be dropped from the Actives list.
     e1.outrec = NULL;
     e2.outrec = NULL;
+    UpdateAelIndex(e1, e2);
   }
   //------------------------------------------------------------------------------
 
@@ -1030,17 +2226,19 @@ namespace clipperlib {
 
   OutPt* Clipper::CreateOutPt()
   {
-    //this is a virtual method as descendant classes may need
-    //to produce descendant classes of OutPt ...
-    return new OutPt();
+    //this is a virtual method as descendant classes may need to produce
+    //descendant classes of OutPt. (OutPts are never deleted individually, so 
+    //descendants must also own the memory, eg with their own MemArena.)
+    return new (outpt_arena_.Alloc()) OutPt();
   }
   //------------------------------------------------------------------------------
 
   OutRec* Clipper::CreateOutRec()
   {
     //this is a virtual method as descendant classes may need
-    //to produce descendant classes of OutRec ...
-    return new OutRec();
+    //to produce descendant classes of OutRec (which, like OutPts, 
+    //descendants must also own, eg with their own MemArena) ...
+    return new (outrec_arena_.Alloc()) OutRec();
   }
   //------------------------------------------------------------------------------
 
@@ -1089,16 +2287,35 @@ namespace clipperlib {
   inline void Clipper::UpdateEdgeIntoAEL(Active *e)
   {
     e->bot = e->top;
+    SplitMaximaPair(*e);
     e->vertex_top = &NextVertex(*e);
     e->top = e->vertex_top->pt;
     e->curr = e->bot;
     SetDx(*e);
+    JoinMaximaPair(*e);
     if (!IsHorizontal(*e)) InsertScanline(e->top.y);
   }
   //------------------------------------------------------------------------------
 
-  void Clipper::IntersectEdges(Active &e1, Active &e2, const Point64 pt)
+#ifdef use_xyz
+  void Clipper::SetZ(Point64 &pt, const Active &e1, const Active &e2)
+  {
+    //intersections at vertices take the vertex's z, otherwise ask the user
+    if (pt == e1.bot) pt.z = e1.bot.z;
+    else if (pt == e1.top) pt.z = e1.top.z;
+    else if (pt == e2.bot) pt.z = e2.bot.z;
+    else if (pt == e2.top) pt.z = e2.top.z;
+    else if (zfill_func_) zfill_func_(e1.bot, e1.top, e2.bot, e2.top, pt);
+    else pt.z = 0;
+  }
+  //------------------------------------------------------------------------------
+#endif
+
+  void Clipper::IntersectEdges(Active &e1, Active &e2, Point64 pt)
   {
+#ifdef use_xyz
+    SetZ(pt, e1, e2);
+#endif
     e1.curr = pt;
     e2.curr = pt;
  
@@ -1134,7 +2351,7 @@ namespace clipperlib {
     //update winding counts...
     //assumes that e1 will be to the right of e2 ABOVE the intersection
     int old_e1_windcnt, old_e2_windcnt;
-    if (e1.local_min->polytype == e2.local_min->polytype) {
+    if (e1.polytype == e2.polytype) {
       if (fillrule_ == frEvenOdd) {
         old_e1_windcnt = e1.wind_cnt;
         e1.wind_cnt = e2.wind_cnt;
@@ -1171,7 +2388,7 @@ namespace clipperlib {
 
     if (IsHotEdge(e1) && IsHotEdge(e2)) {
       if ((old_e1_windcnt != 0 && old_e1_windcnt != 1) || (old_e2_windcnt != 0 && old_e2_windcnt != 1) ||
-        (e1.local_min->polytype != e2.local_min->polytype && cliptype_ != ctXor))
+        (e1.polytype != e2.polytype && cliptype_ != ctXor))
       {
         AddLocalMaxPoly(e1, e2, pt);
       }
@@ -1183,18 +2400,21 @@ namespace clipperlib {
         AddOutPt(e1, pt);
         AddOutPt(e2, pt);
         SwapOutrecs(e1, e2);
+        UpdateAelIndex(e1, e2);
       }
     }
     else if (IsHotEdge(e1)) {
       if (old_e2_windcnt == 0 || old_e2_windcnt == 1) {
         AddOutPt(e1, pt);
         SwapOutrecs(e1, e2);
+        UpdateAelIndex(e1, e2);
       }
     }
     else if (IsHotEdge(e2)) {
       if (old_e1_windcnt == 0 || old_e1_windcnt == 1) {
         AddOutPt(e2, pt);
         SwapOutrecs(e1, e2);
+        UpdateAelIndex(e1, e2);
       }
     }
     else if ((old_e1_windcnt == 0 || old_e1_windcnt == 1) &&
@@ -1251,7 +2471,10 @@ namespace clipperlib {
     if (prev) prev->next_in_ael = next;
     else actives_ = next;
     if (next) next->prev_in_ael = prev;
-    delete &e;
+    if (ael_index_) ael_index_->Remove(e);
+    SplitMaximaPair(e);
+    --ael_width_;
+    active_arena_.Free(&e);
   }
   //------------------------------------------------------------------------------
 
@@ -1285,18 +2508,91 @@ namespace clipperlib {
     if (ct == ctNone) return true;
     fillrule_ = ft;
     cliptype_ = ct;
-    Reset();
 
     int64_t y;
-    if (!PopScanline(y)) { return false; }
-    for (;;) {
-      InsertLocalMinimaIntoAEL(y);
-      Active *e;
-      while (PopHorz(e)) ProcessHorizontal(*e);
-      if (!PopScanline(y)) break;   //Y is now at the top of the scanbeam
-      ProcessIntersections(y);
-      DoTopOfScanbeam(y);
-    } 
+    try {
+      Reset();
+      if (!PopScanline(y)) { return false; }
+      for (;;) {
+        if (pipe_) WaitForMinima(*pipe_, y);
+        InsertLocalMinimaIntoAEL(y);
+        Active *e;
+        while (PopHorz(e)) ProcessHorizontal(*e);
+        if (stop_requested_) break;
+        int64_t bot_y = y;
+        if (!PopScanline(y)) break;   //Y is now at the top of the scanbeam
+        DoScanbeam(bot_y, y);
+        ProcessIntersections(y);
+        DoTopOfScanbeam(y);
+      }
+    }
+    catch (...) {
+      //leave this Clipper ready for another Execute (though a pipelined
+      //Execute must first wait for its builder) ...
+      if (!pipe_) {
+        CleanUp();
+        ClearMaximaPairs();
+      }
+      throw;
+    }
+    return true;
+  }
+  //------------------------------------------------------------------------------
+
+  bool Clipper::ExecutePipelined(ClipType ct, FillRule ft, 
+    Paths &solution_closed, Paths *solution_open)
+  {
+    Pipeline pipe;
+    try {
+      pipe.builder = std::thread(OutRecBuilder, &pipe);
+    }
+    catch (const std::system_error&) {
+      //without another thread, just Execute as usual ...
+      if (!ExecuteInternal(ct, ft)) return false;
+      BuildResult(solution_closed, solution_open);
+      CleanUp();
+      return true;
+    }
+    pipe_ = &pipe;
+    bool result = false;
+    try {
+      result = ExecuteInternal(ct, ft);
+    }
+    catch (...) {
+      pipe.SetError();
+    }
+    PassOnOutRecs(pipe, true);
+    pipe.builder.join();
+    if (pipe.sorter.joinable()) pipe.sorter.join();
+    pipe_ = NULL;
+    if (pipe.failed) {
+      CleanUp();
+      ClearMaximaPairs();
+      std::rethrow_exception(pipe.error);
+    }
+    if (!result) return false;
+
+    //merge the paths that were built during the sweep with the rest (in the
+    //same order as BuildResult) ...
+    std::sort(pipe.paths.begin(), pipe.paths.end(), PathIdxLess());
+    solution_closed.reserve(outrec_list_.size());
+    size_t k = 0;
+    for (OutRecList::const_iterator ol_iter = outrec_list_.begin(); 
+      ol_iter != outrec_list_.end(); ++ol_iter) 
+    {
+      OutRec *outrec = *ol_iter;
+      bool is_open = (outrec->flag == orOpen);
+      if (is_open && !solution_open) continue;
+      Paths &solution = is_open ? *solution_open : solution_closed;
+      if (k < pipe.paths.size() && pipe.paths[k].first == outrec->idx) {
+        solution.push_back(Path());
+        solution.back().swap(pipe.paths[k++].second);
+        continue;
+      }
+      Path p;
+      if (BuildPath(*outrec, p)) solution.push_back(p);
+    }
+    CleanUp();
     return true;
   }
   //------------------------------------------------------------------------------
@@ -1304,6 +2600,7 @@ namespace clipperlib {
   bool Clipper::Execute(ClipType clipType, Paths &solution_closed, FillRule ft)
   {
     solution_closed.clear();
+    if (pipelined_) return ExecutePipelined(clipType, ft, solution_closed, NULL);
     if (!ExecuteInternal(clipType, ft)) return false;
     BuildResult(solution_closed, NULL);
     CleanUp();
@@ -1315,6 +2612,7 @@ namespace clipperlib {
   {
     solution_closed.clear();
     solution_open.clear();
+    if (pipelined_) return ExecutePipelined(clipType, ft, solution_closed, &solution_open);
     if (!ExecuteInternal(clipType, ft)) return false;
     BuildResult(solution_closed, &solution_open);
     CleanUp();
@@ -1336,6 +2634,16 @@ namespace clipperlib {
   {
     BuildIntersectList(top_y);
     if (intersect_list_.size() == 0) return;
+    if (ael_index_) {
+      //drop the index (until the next Execute) if it's costing more than it
+      //saves, as it does when the sweep is busier with intersections than
+      //with new local minima ...
+      ael_index_->swaps += intersect_list_.size();
+      if (ael_index_->swaps * AEL_INDEX_SWAP_COST > ael_index_->saved + ael_width_) {
+        DisposeAelIndex();
+        ael_index_off_ = true;
+      }
+    }
     FixupIntersectionOrder();
     ProcessIntersectList();
   }
@@ -1345,12 +2653,12 @@ namespace clipperlib {
   {
     for (IntersectList::iterator node_iter = intersect_list_.begin();
       node_iter != intersect_list_.end(); ++node_iter) 
-        delete (*node_iter);
+        intersect_arena_.Free(*node_iter); //nb: recycled by later scanbeams
     intersect_list_.resize(0);
   }
   //------------------------------------------------------------------------------
 
-  void Clipper::InsertNewIntersectNode(Active &e1, Active &e2, int64_t top_y)
+  Point64 GetScanbeamIntersectPt(const Active &e1, const Active &e2, int64_t top_y)
   {
     Point64 pt = GetIntersectPoint(e1, e2);
 
@@ -1370,27 +2678,49 @@ namespace clipperlib {
       else if (Abs(e1.dx) < Abs(e2.dx)) pt.x = e1.curr.x;
       else pt.x = e2.curr.x;
     }
+    return pt;
+  }
+  //------------------------------------------------------------------------------
 
-    IntersectNode *node = new IntersectNode();
+  void Clipper::InsertNewIntersectNode(Active &e1, Active &e2, int64_t top_y)
+  {
+    IntersectNode *node = new (intersect_arena_.Alloc()) IntersectNode();
     node->edge1 = &e1;
     node->edge2 = &e2;
-    node->pt = pt;
+    node->pt = GetScanbeamIntersectPt(e1, e2, top_y);
     intersect_list_.push_back(node);
   }
   //------------------------------------------------------------------------------
 
-  void Clipper::BuildIntersectList(const int64_t top_y)
+  inline void Insert2Before1InSel(Active &first, Active &second)
   {
-    if (!actives_ || !actives_->next_in_ael) return;
-    CopyActivesToSELAdjustCurrX(top_y);
+    //remove second from list ...
+    Active *prev = second.prev_in_sel;
+    Active *next = second.next_in_sel;
+    prev->next_in_sel = next; //always a prev since we're moving from right to left
+    if (next) next->prev_in_sel = prev;
+    //insert back into list ...
+    prev = first.prev_in_sel;
+    if (prev) prev->next_in_sel = &second;
+    first.prev_in_sel = &second;
+    second.prev_in_sel = prev;
+    second.next_in_sel = &first;
+  }
+  //------------------------------------------------------------------------------
 
-    //Merge sort actives_ into their new positions at the top of scanbeam, and
-    //create an intersection node every time an edge crosses over another ...
-    //see also https://stackoverflow.com/a/46319131/359538 
-    int mul = 1;
+  //SortSel: merge sorts the SEL (starting at sel) into its new order at the top
+  //of the scanbeam, beginning with groups of 'mul' edges, and calls 
+  //add_node(e1, e2, round) every time an edge crosses over another. Returns
+  //the new start of the SEL ...
+  //see also https://stackoverflow.com/a/46319131/359538 
+  template <typename AddNode>
+  Active* SortSel(Active *sel, int mul, AddNode &add_node)
+  {
+    int round = 0;
+    for (int m = mul; m > 1; m >>= 1) ++round;
     while (true) {
 
-      Active *first = sel_, *second = NULL, *baseE, *prev_base = NULL, *tmp;
+      Active *first = sel, *second = NULL, *baseE, *prev_base = NULL, *tmp;
       //sort successive larger 'mul' count of nodes ...
       while (first) {
         if (mul == 1) {
@@ -1419,7 +2749,7 @@ namespace clipperlib {
             tmp = second->prev_in_sel;
             for (int i = 0; i < lCnt; ++i) {
               //create a new intersect node...
-              InsertNewIntersectNode(*tmp, *second, top_y);
+              add_node(*tmp, *second, round);
               tmp = tmp->prev_in_sel;
             }
             /////////////////////////////////////////////////
@@ -1428,7 +2758,7 @@ namespace clipperlib {
               if (prev_base) prev_base->merge_jump = second;
               baseE = second;
               baseE->merge_jump = first->merge_jump;
-              if (!first->prev_in_sel) sel_ = second;
+              if (!first->prev_in_sel) sel = second;
             }
             tmp = second->next_in_sel;
             //now move the out of place edge to it's new position in SEL ...
@@ -1445,9 +2775,148 @@ namespace clipperlib {
         first = baseE->merge_jump;
         prev_base = baseE;
       }
-      if (!sel_->merge_jump) break;
-      else mul <<= 1;
+      if (!sel->merge_jump) break;
+      mul <<= 1;
+      ++round;
+    }
+    return sel;
+  }
+  //------------------------------------------------------------------------------
+
+  //SelChunks: the SEL split into chunks that are sorted in parallel (see 
+  //SortSelInChunks), with the intersections found in each chunk kept by
+  //round so they can be added in the same order as a serial SortSel. Waking
+  //a thread costs about as much as sorting a few thousand edges, so chunks 
+  //are at least PAR_MIN_CHUNK_SIZE edges ...
+#ifndef PAR_MIN_CHUNK_SIZE
+  #define PAR_MIN_CHUNK_SIZE (4096)
+#endif
+
+  struct SelChunk {
+    Active      *head;
+    Active      *tail;
+    std::vector< std::vector< IntersectNode > > rounds;
+  };
+
+  struct SelJob : public WorkerJob {
+    std::vector< Active* > edges;   //in AEL order
+    size_t       chunk_size;        //a power of 2 (as SortSel's groups are)
+    int64_t      top_y;
+    std::vector< SelChunk > chunks;
+  };
+
+  struct ChunkNodeAdder {
+    SelChunk    *chunk;
+    int64_t      top_y;
+    void operator()(Active &e1, Active &e2, int round)
+    {
+      if (size_t(round) >= chunk->rounds.size()) chunk->rounds.resize(round + 1);
+      IntersectNode node;
+      node.edge1 = &e1;
+      node.edge2 = &e2;
+      node.pt = GetScanbeamIntersectPt(e1, e2, top_y);
+      chunk->rounds[round].push_back(node);
     }
+  };
+
+  void SortSelWorker(WorkerJob *worker_job)
+  {
+    SelJob *job = static_cast<SelJob*>(worker_job);
+    for (;;) {
+      size_t i = job->next++;
+      if (i >= job->chunks.size() || job->failed) break;
+      size_t start = i * job->chunk_size;
+      size_t end = std::min(start + job->chunk_size, job->edges.size());
+      for (size_t j = start; j < end; ++j) {
+        Active *e = job->edges[j];
+        e->prev_in_sel = (j == start) ? NULL : job->edges[j - 1];
+        e->next_in_sel = (j + 1 == end) ? NULL : job->edges[j + 1];
+        e->curr.x = TopX(*e, job->top_y);
+      }
+      ChunkNodeAdder add_node = { &job->chunks[i], job->top_y };
+      Active *e = SortSel(job->edges[start], 1, add_node);
+      job->chunks[i].head = e;
+      while (e->next_in_sel) e = e->next_in_sel;
+      job->chunks[i].tail = e;
+    }
+  }
+  //------------------------------------------------------------------------------
+
+  int Clipper::SortSelInChunks(const int64_t top_y)
+  {
+    //the first rounds of SortSel merge groups that lie entirely within a chunk
+    //(given power of 2 sized chunks), so they're done in parallel, and the
+    //rounds that merge the sorted chunks are left to BuildIntersectList ...
+    unsigned pool_cnt = par_thread_cnt_;
+    if (!pool_cnt) pool_cnt = std::thread::hardware_concurrency();
+    unsigned thread_cnt = pool_cnt;
+    if (thread_cnt > ael_width_ / PAR_MIN_CHUNK_SIZE) 
+      thread_cnt = unsigned(ael_width_ / PAR_MIN_CHUNK_SIZE);
+    if (thread_cnt < 2) {
+      CopyActivesToSELAdjustCurrX(top_y);
+      return 1;
+    }
+    //the pool's threads are kept for the rest of the sweep (see CleanUp) ...
+    if (!par_pool_) 
+      par_pool_ = new (mr_->Allocate(sizeof(WorkerPool))) WorkerPool(pool_cnt);
+
+    SelJob job;
+    job.edges.reserve(ael_width_);
+    for (Active *e = actives_; e; e = e->next_in_ael) job.edges.push_back(e);
+    job.chunk_size = 2;
+    while (job.chunk_size * thread_cnt < job.edges.size()) job.chunk_size <<= 1;
+    job.chunks.resize((job.edges.size() + job.chunk_size - 1) / job.chunk_size);
+    job.top_y = top_y;
+    par_pool_->Run(job, SortSelWorker);
+
+    //join the sorted chunks (with merge_jump linking each chunk to the next,
+    //as at the end of a SortSel round) ...
+    size_t cnt = job.chunks.size();
+    for (size_t i = 0; i < cnt; ++i) {
+      SelChunk &chunk = job.chunks[i];
+      if (i + 1 < cnt) {
+        chunk.tail->next_in_sel = job.chunks[i + 1].head;
+        job.chunks[i + 1].head->prev_in_sel = chunk.tail;
+        chunk.head->merge_jump = job.chunks[i + 1].head;
+      }
+      else chunk.head->merge_jump = NULL;
+    }
+    sel_ = job.chunks[0].head;
+
+    //and add the intersections round by round, chunk by chunk ...
+    size_t round_cnt = 0;
+    for (size_t i = 0; i < cnt; ++i)
+      round_cnt = std::max(round_cnt, job.chunks[i].rounds.size());
+    for (size_t r = 0; r < round_cnt; ++r)
+      for (size_t i = 0; i < cnt; ++i) {
+        if (r >= job.chunks[i].rounds.size()) continue;
+        std::vector< IntersectNode > &nodes = job.chunks[i].rounds[r];
+        for (size_t j = 0; j < nodes.size(); ++j)
+          intersect_list_.push_back(
+            new (intersect_arena_.Alloc()) IntersectNode(nodes[j]));
+      }
+    return int(job.chunk_size);
+  }
+  //------------------------------------------------------------------------------
+
+  void Clipper::BuildIntersectList(const int64_t top_y)
+  {
+    if (!actives_ || !actives_->next_in_ael) return;
+
+    struct SerialNodeAdder {
+      Clipper    *clipper;
+      int64_t     top_y;
+      void operator()(Active &e1, Active &e2, int) 
+        { clipper->InsertNewIntersectNode(e1, e2, top_y); }
+    };
+    SerialNodeAdder add_node = { this, top_y };
+
+    int mul = 1;
+    if (par_min_width_ && ael_width_ >= par_min_width_)
+      mul = SortSelInChunks(top_y);
+    else
+      CopyActivesToSELAdjustCurrX(top_y);
+    sel_ = SortSel(sel_, mul, add_node);
   }
   //------------------------------------------------------------------------------
 
@@ -1531,6 +3000,7 @@ namespace clipperlib {
 
     if (!e1.prev_in_ael) actives_ = &e1;
     else if (!e2.prev_in_ael) actives_ = &e2;
+    if (ael_index_) ael_index_->Swap(e1, e2);
   }
   //------------------------------------------------------------------------------
 
@@ -1577,22 +3047,6 @@ namespace clipperlib {
   }
   //------------------------------------------------------------------------------
 
-  void Clipper::Insert2Before1InSel(Active &first, Active &second)
-  {
-    //remove second from list ...
-    Active *prev = second.prev_in_sel;
-    Active *next = second.next_in_sel;
-    prev->next_in_sel = next; //always a prev since we're moving from right to left
-    if (next) next->prev_in_sel = prev;
-    //insert back into list ...
-    prev = first.prev_in_sel;
-    if (prev) prev->next_in_sel = &second;
-    first.prev_in_sel = &second;
-    second.prev_in_sel = prev;
-    second.next_in_sel = &first;
-  }
-  //------------------------------------------------------------------------------
-
   bool Clipper::ResetHorzDirection(Active &horz, Active *max_pair, int64_t &horz_left, int64_t &horz_right)
   {
     if (horz.bot.x == horz.top.x) {
@@ -1799,6 +3253,21 @@ namespace clipperlib {
   }
   //------------------------------------------------------------------------------
 
+  bool Clipper::BuildPathsInParallel(Paths &paths, bool open_paths)
+  {
+    if (!build_min_outrecs_ || outrec_list_.size() < build_min_outrecs_) return false;
+    BuildJob job;
+    job.outrecs = &outrec_list_;
+    job.paths = &paths;
+    job.open_paths = open_paths;
+    paths.resize(outrec_list_.size());
+
+    size_t chunk_cnt = (outrec_list_.size() + BUILD_CHUNK_SIZE - 1) / BUILD_CHUNK_SIZE;
+    RunWorkers(job, PathsBuilder, build_thread_cnt_, chunk_cnt);
+    return true;
+  }
+  //------------------------------------------------------------------------------
+
   void Clipper::BuildResult(Paths &solution_closed, Paths *solution_open)
   {
     solution_closed.resize(0);
@@ -1807,24 +3276,22 @@ namespace clipperlib {
       solution_open->resize(0);
       solution_open->reserve(outrec_list_.size());
     }
-    
-    for (OutRecList::const_iterator ol_iter = outrec_list_.begin(); 
-      ol_iter != outrec_list_.end(); ++ol_iter) 
-    {
-      OutRec *outrec = *ol_iter;
-      if (!outrec->pts) continue;
-      OutPt *op = outrec->pts->next;
-      int cnt = PointCount(op);
-      //fixup for duplicate start and } points ...
-      if (op->pt == outrec->pts->pt) cnt--;
 
+    //paths may already be built (in parallel), otherwise they're built here
+    Paths built;
+    bool is_built = BuildPathsInParallel(built, solution_open != NULL);
+    for (size_t i = 0; i < outrec_list_.size(); ++i)
+    {
+      OutRec *outrec = outrec_list_[i];
       bool is_open = (outrec->flag == orOpen);
-      if (cnt < 2 || (!is_open && cnt == 2) || (is_open && !solution_open)) continue;
+      if (is_open && !solution_open) continue;
       Path p;
-      p.reserve(cnt);
-      for (int i = 0; i < cnt; i++) { p.push_back(op->pt); op = op->next; }
-      if (is_open) solution_open->push_back(p);
-      else solution_closed.push_back(p);
+      if (is_built) p.swap(built[i]);
+      else BuildPath(*outrec, p);
+      if (p.empty()) continue;
+      Paths &solution = is_open ? *solution_open : solution_closed;
+      solution.push_back(Path());
+      solution.back().swap(p);
     }
   }
   //------------------------------------------------------------------------------
@@ -1837,28 +3304,29 @@ namespace clipperlib {
       solution_open->reserve(outrec_list_.size());
     }
 
-    for (OutRecList::const_iterator ol_iter = outrec_list_.begin(); 
-      ol_iter != outrec_list_.end(); ++ol_iter) 
+    //paths may already be built (in parallel), leaving only the nesting here
+    Paths built;
+    bool is_built = BuildPathsInParallel(built, solution_open != NULL);
+    for (size_t i = 0; i < outrec_list_.size(); ++i)
     {
-      OutRec *outrec = *ol_iter;
-      if (!outrec->pts) continue;
-      OutPt *op = outrec->pts->next;
-      int cnt = PointCount(op);
-      //fixup for duplicate start and } points ...
-      if (op->pt == outrec->pts->pt) cnt--;
-
+      OutRec *outrec = outrec_list_[i];
       bool is_open = (outrec->flag == orOpen);
-      if (cnt < 2 || (!is_open && cnt == 2) || (is_open && !solution_open)) continue;
-
+      if (is_open && !solution_open) continue;
       Path p;
-      p.reserve(cnt);
-      for (int i = 0; i < cnt; i++) { p.push_back(op->pt); op = op->next; }
-      if (is_open) 
-        solution_open->push_back(p);
-      else if (outrec->owner && outrec->owner->polypath)
-        outrec->polypath = &outrec->owner->polypath->AddChild(p);
+      if (is_built) p.swap(built[i]);
+      else BuildPath(*outrec, p);
+      if (p.empty()) continue;
+
+      if (is_open) {
+        solution_open->push_back(Path());
+        solution_open->back().swap(p);
+        continue;
+      }
+      if (outrec->owner && outrec->owner->polypath)
+        outrec->polypath = &outrec->owner->polypath->AddChild(Path());
       else
-        outrec->polypath = &pt.AddChild(p);
+        outrec->polypath = &pt.AddChild(Path());
+      outrec->polypath->GetPath().swap(p);
     }
   }
   //------------------------------------------------------------------------------
@@ -1885,7 +3353,11 @@ namespace clipperlib {
 
   std::ostream& operator <<(std::ostream &s, const Point64 &pt)
   {
+#ifdef use_xyz
+    s << pt.x << "," << pt.y << "," << pt.z << " ";
+#else
     s << pt.x << "," << pt.y << " ";
+#endif
     return s;
   }
   //------------------------------------------------------------------------------
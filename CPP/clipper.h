@@ -13,11 +13,18 @@
 
 #define CLIPPER_VERSION "10.0.0"
 
+//use_xyz: adds a Z member to Point64 (a user payload, eg elevation or an id)
+//that's carried from each input vertex into the solution. Z values for new
+//vertices (ie at edge intersections) come from the ZFillCallback (see below).
+//#define use_xyz
+
 #include <vector>
 #include <queue>
 #include <stdexcept>
 #include <cstdlib>
 #include <cfloat>
+#include <atomic>
+#include <exception>
 
 namespace clipperlib {
 
@@ -32,7 +39,12 @@ enum FillRule { frEvenOdd, frNonZero, frPositive, frNegative };
 struct Point64 {
   int64_t x;
   int64_t y;
+#ifdef use_xyz
+  int64_t z;
+  Point64(int64_t x = 0, int64_t y = 0, int64_t z = 0): x(x), y(y), z(z) {}
+#else
   Point64(int64_t x = 0, int64_t y = 0): x(x), y(y) {}
+#endif
 
   friend inline bool operator== (const Point64 &a, const Point64 &b)
   {
@@ -46,6 +58,13 @@ struct Point64 {
 
 typedef std::vector< Point64 > Path;
 typedef std::vector< Path > Paths;
+typedef std::vector< Paths > PathsList;
+
+#ifdef use_xyz
+//ZFillCallback: sets pt.z where the edges e1 (e1bot to e1top) and e2 intersect
+typedef void (*ZFillCallback)(const Point64 &e1bot, const Point64 &e1top, 
+  const Point64 &e2bot, const Point64 &e2top, Point64 &pt);
+#endif
 
 inline Path& operator <<(Path &path, const Point64 &pt) {path.push_back(pt); return path;}
 inline Paths& operator <<(Paths &paths, const Path &path) {paths.push_back(path); return paths;}
@@ -54,14 +73,60 @@ std::ostream& operator <<(std::ostream &s, const Point64 &p);
 std::ostream& operator <<(std::ostream &s, const Path &p);
 std::ostream& operator <<(std::ostream &s, const Paths &p);
 
+//MemoryResource: where the clipping engines get their memory (much like C++17's
+//std::pmr::memory_resource). Allocate must return memory that's aligned for
+//any type, and Deallocate is passed the same size that was allocated. An
+//engine only uses its resource from the calling thread, except where it's
+//shared with worker threads (eg ClipperOffset's grouped Execute), so only
+//then must the resource be thread safe. The engines' internal lists use it
+//too (see ResourceAllocator), but the Path and Paths of solutions don't.
+class MemoryResource
+{
+  public:
+    virtual ~MemoryResource() {}
+    virtual void *Allocate(size_t bytes) = 0;
+    virtual void Deallocate(void *p, size_t bytes) = 0;
+};
+
+//DefaultMemoryResource: the global heap (ie operator new and delete), which
+//is used whenever an engine is given a NULL resource.
+MemoryResource *DefaultMemoryResource();
+
+//ResourceAllocator: a C++11 allocator that gets its memory from a
+//MemoryResource (or the global heap when that's NULL), so std containers
+//can share an engine's resource.
+template <typename T>
+class ResourceAllocator
+{
+  public:
+    typedef T value_type;
+    explicit ResourceAllocator(MemoryResource *mr = NULL) : 
+      mr_(mr ? mr : DefaultMemoryResource()) {}
+    template <typename U>
+    ResourceAllocator(const ResourceAllocator<U> &other) : mr_(other.resource()) {}
+    T *allocate(size_t n) { return static_cast<T*>(mr_->Allocate(n * sizeof(T))); }
+    void deallocate(T *p, size_t n) { mr_->Deallocate(p, n * sizeof(T)); }
+    MemoryResource *resource() const { return mr_; }
+  private:
+    MemoryResource *mr_;
+};
+
+template <typename T, typename U>
+inline bool operator ==(const ResourceAllocator<T> &a, const ResourceAllocator<U> &b)
+  { return a.resource() == b.resource(); }
+template <typename T, typename U>
+inline bool operator !=(const ResourceAllocator<T> &a, const ResourceAllocator<U> &b)
+  { return a.resource() != b.resource(); }
+
 class PolyPath
 { 
   private:
 	  PolyPath *parent_;
 	  Path path_;
-	  std::vector< PolyPath* > childs_;
+    MemoryResource *mr_;  //for child PolyPaths (shared by the whole tree)
+	  std::vector< PolyPath*, ResourceAllocator< PolyPath* > > childs_;
   public:
-	  PolyPath(PolyPath *parent, const Path &path);
+	  PolyPath(PolyPath *parent, const Path &path, MemoryResource *mr = NULL);
       virtual ~PolyPath(){}
     PolyPath &AddChild(const Path &path);
 	  PolyPath& GetChild(unsigned index);
@@ -72,7 +137,12 @@ class PolyPath
 	  void Clear();
 };
 
-class PolyTree : public PolyPath {};
+class PolyTree : public PolyPath 
+{
+  public:
+    explicit PolyTree(MemoryResource *mr = NULL) : PolyPath(NULL, Path(), mr) {}
+    ~PolyTree() { Clear(); }
+};
 
 struct Rect64 { 
 	int64_t left; 
@@ -87,6 +157,10 @@ struct IntersectNode;
 struct Active;
 struct Vertex;
 struct LocalMinima;
+struct AelNode;
+struct AelIndex;
+struct Pipeline;
+struct WorkerPool;
 
 class OutPt {
 public:
@@ -109,6 +183,50 @@ struct OutRec {
   OutRecFlag  flag;
 };
 
+//MemArena: hands out fixed size chunks carved from large blocks. Chunks may be
+//recycled individually (Free), but the blocks are only released by Clear (or
+//on destruction), so disposing of every OutPt in a solution costs next to
+//nothing and list nodes that are created together also sit together in memory.
+//Blocks come from mr (or the global heap when mr is NULL).
+class MemArena {
+  public:
+    explicit MemArena(size_t chunk_size, MemoryResource *mr = NULL);
+    ~MemArena();
+    void *Alloc();
+    void Free(void *chunk);
+    void Clear();
+  private:
+    size_t            chunk_size_;
+    size_t            block_size_;
+    std::vector< char*, ResourceAllocator< char* > > blocks_;
+    char             *pos_;
+    char             *end_;
+    void             *free_list_;
+    MemoryResource   *mr_;
+    MemArena(const MemArena&);             //not copyable
+    MemArena& operator=(const MemArena&);
+};
+
+//WorkerJob: work that's shared among threads by RunWorkers. Workers take
+//items (or chunks of them) from 'next' until there are none left, and they
+//also stop once another worker has failed.
+struct WorkerJob {
+  std::atomic< size_t > next;
+  std::atomic< bool > failed;
+  std::exception_ptr error;   //the first exception thrown by any worker
+  WorkerJob() : next(0), failed(false) {}
+  void SetError();            //call from a catch block (keeps the first only)
+};
+
+typedef void (*WorkerFunc)(WorkerJob *job);
+
+//RunWorkers: runs worker(&job) on up to thread_cnt threads (0: one per 
+//hardware thread), but no more than max_threads, and the calling thread is
+//always one of them. If fewer threads can be started, the work is shared 
+//among those that were. Once all have finished, the first error is rethrown.
+void RunWorkers(WorkerJob &job, WorkerFunc worker, unsigned thread_cnt, 
+  size_t max_threads);
+
 //Active: an edge in the AEL that may or may not be 'hot' (part of the clip solution).
 struct Active {
   Point64      bot;
@@ -124,18 +242,27 @@ struct Active {
   Active      *next_in_sel;
   Active      *prev_in_sel;
   Active      *merge_jump;
+  Active      *max_pair;     //the other bound sharing vertex_top (a local maxima)
   Vertex      *vertex_top;
   LocalMinima *local_min;    //bottom of bound
+  PathType     polytype;     //copied from local_min (avoids the indirection)
+  bool         is_open;      //copied from local_min
+  int          path_id;      //copied from local_min (see AddPath)
+  AelNode     *ael_node;     //only used when the AEL is indexed (see AelIndex)
 };
 
+//nb: a Clipper's lists draw on its MemoryResource ...
+typedef std::vector< OutRec*, ResourceAllocator< OutRec* > > OutRecList;
+typedef std::vector< LocalMinima*, ResourceAllocator< LocalMinima* > > MinimaList;
+
 class Clipper {
   private:
-    typedef std::vector < OutRec* > OutRecList;
-	  typedef std::vector < IntersectNode* > IntersectList;
-	  typedef std::priority_queue< int64_t > ScanlineList;
-    typedef std::vector< LocalMinima* > MinimaList;
-    typedef std::vector< Vertex* > VerticesList;
+	  typedef std::vector < IntersectNode*, ResourceAllocator< IntersectNode* > > IntersectList;
+	  typedef std::priority_queue< int64_t, 
+      std::vector< int64_t, ResourceAllocator< int64_t > > > ScanlineList;
+    typedef std::vector< Vertex*, ResourceAllocator< Vertex* > > VerticesList;
 
+    MemoryResource   *mr_;
 	  ClipType          cliptype_;
     FillRule          fillrule_;
     Active	         *actives_;
@@ -143,28 +270,57 @@ class Clipper {
     bool			        has_open_paths_;
     MinimaList        minima_list_;
     MinimaList::iterator curr_loc_min_;
-    bool			        minima_list_sorted_;
+    size_t            minima_sorted_cnt_; //minima_list_ is sorted up to here
+    bool              stop_requested_;
+    int               path_cnt_;    //the next path_id (see AddPath)
+#ifdef use_xyz
+    ZFillCallback     zfill_func_;
+    void SetZ(Point64 &pt, const Active &e1, const Active &e2);
+#endif
     OutRecList		    outrec_list_;
     IntersectList     intersect_list_;
     VerticesList      vertex_list_;
     ScanlineList		  scanline_list_;
+    AelIndex         *ael_index_;
+    size_t            ael_width_;
+    bool              ael_index_off_;  //see ProcessIntersections
+    size_t            par_min_width_;  //see ParallelIntersections
+    unsigned          par_thread_cnt_;
+    WorkerPool       *par_pool_;       //only during an Execute
+    bool              pipelined_;      //see PipelinedExecute
+    Pipeline         *pipe_;           //only during a pipelined Execute
+    size_t            build_min_outrecs_; //see ParallelBuildResult
+    unsigned          build_thread_cnt_;
+    MemArena          outpt_arena_;
+    MemArena          active_arena_;
+    MemArena          intersect_arena_;
+    MemArena          minima_arena_;
+    MemArena          outrec_arena_;
     void Reset();
+    void ClearMaximaPairs();
     void InsertScanline(int64_t y);
     bool PopScanline(int64_t &y);
     bool PopLocalMinima(int64_t y, LocalMinima *&local_minima);
     void DisposeAllOutRecs();
     void DisposeVerticesAndLocalMinima();
-    void AddLocMin(Vertex &vert, PathType polytype, bool is_open);
+    Vertex* NewVertices(size_t cnt);
+    void AddLocMin(Vertex &vert, PathType polytype, bool is_open, bool flag_only = false);
+    bool SetVertexFlags(Vertex *first, PathType polytype, bool is_open, bool flag_only);
     void AddPathToVertexList(const Path &p, PathType polytype, bool is_open);
     bool IsContributingClosed(const Active &e) const;
     inline bool IsContributingOpen(const Active &e) const;
     void SetWindingLeftEdgeClosed(Active &edge);
     void SetWindingLeftEdgeOpen(Active &e);
+    void BuildAelIndex();
+    void DisposeAelIndex();
+    void DisposeParPool();
+    inline void UpdateAelIndex(Active &e1, Active &e2);
     void InsertEdgeIntoAEL(Active &edge, Active *startEdge);
     virtual void InsertLocalMinimaIntoAEL(int64_t bot_y);
     inline void PushHorz(Active &e);
     inline bool PopHorz(Active *&e);
     inline OutRec* GetOwner(const Active *e);
+    bool FixOrientation(Active &e);
     void JoinOutrecPaths(Active &e1, Active &e2);
     inline void TerminateHotOpen(Active &e);
     inline void StartOpenPath(Active &e, const Point64 pt);
@@ -177,16 +333,18 @@ class Clipper {
     void DisposeIntersectNodes();
     void InsertNewIntersectNode(Active &e1, Active &e2, const int64_t top_y);
     void BuildIntersectList(const int64_t top_y);
+    int SortSelInChunks(const int64_t top_y);
     bool ProcessIntersectList();
     void FixupIntersectionOrder();
     void SwapPositionsInAEL(Active &edge1, Active &edge2);
     void SwapPositionsInSEL(Active &edge1, Active &edge2);
-    inline void Insert2Before1InSel(Active &first, Active &second);
     bool ResetHorzDirection(Active &horz, Active *max_pair, int64_t &horz_left, int64_t &horz_right);
     void ProcessHorizontal(Active &horz);
     void DoTopOfScanbeam(const int64_t top_y);
     Active* DoMaxima(Active &e);
+    bool BuildPathsInParallel(Paths &paths, bool open_paths);
     void BuildResult(Paths &paths_closed, Paths *paths_open);
+    bool ExecutePipelined(ClipType ct, FillRule ft, Paths &paths_closed, Paths *paths_open);
     void BuildResult2(PolyTree &pt, Paths *solution_open);
   protected:
     void CleanUp();
@@ -196,18 +354,60 @@ class Clipper {
     virtual void AddLocalMinPoly(Active &e1, Active &e2, const Point64 pt);
     virtual void AddLocalMaxPoly(Active &e1, Active &e2, const Point64 pt);
     bool ExecuteInternal(ClipType ct, FillRule ft);
+    bool IsLeftBound(const Active &e) const;
+    void StopExecute() { stop_requested_ = true; } //ends the sweep early
+    //DoScanbeam: called once the AEL is ready for the scanbeam from bot_y up
+    //to top_y, and before any of its intersections have been processed.
+    virtual void DoScanbeam(const int64_t /*bot_y*/, const int64_t /*top_y*/) {}
     /*get properties ... */
     OutRecList& outrec_list() { return outrec_list_; }
+    Active* actives() { return actives_; }
+    int path_cnt() const { return path_cnt_; } //ie the next path_id
   public:
-    Clipper();
+    //mr: where the engine's vertices, edges, solution points etc come from
+    //(NULL: the global heap). Descendant classes pass on their own mr.
+    explicit Clipper(MemoryResource *mr = NULL);
     virtual ~Clipper();
     virtual void AddPath(const Path &path, PathType polytype, bool is_open = false);
     virtual void AddPaths(const Paths &paths, PathType polytype, bool is_open = false);
     virtual bool Execute(ClipType clipType, Paths &solution_closed, FillRule fr = frEvenOdd);
     virtual bool Execute(ClipType clipType, Paths &solution_closed, Paths &solution_open, FillRule fr = frEvenOdd);
     virtual bool Execute(ClipType clipType, PolyTree &solution_closed, Paths &solution_open, FillRule fr = frEvenOdd);
-    void Clear();
+    virtual void Clear();
     Rect64 GetBounds();
+    //ParallelIntersections: in scanbeams where the AEL is at least min_width 
+    //edges wide, edges are moved to the top of the scanbeam and sorted (to find
+    //their intersections) in chunks on thread_cnt threads (0: one per hardware
+    //thread). The intersections found are identical to those found serially.
+    //The threads are started once per Execute, and each is only given work
+    //when there are enough edges (see PAR_MIN_CHUNK_SIZE) for it to be worth
+    //waking. A min_width of 0 (the default) disables this.
+    void ParallelIntersections(size_t min_width, unsigned thread_cnt = 0)
+      { par_min_width_ = min_width; par_thread_cnt_ = thread_cnt; }
+    //PipelinedExecute: Execute (but not the PolyTree version) then overlaps
+    //its three stages: local minima are sorted in blocks on one thread while
+    //the sweep consumes them, and closed paths are copied to the solution on
+    //another. Paths sharing a y may be processed in a different order, so 
+    //the solution may start paths at different vertices.
+    void PipelinedExecute(bool pipelined = true) { pipelined_ = pipelined; }
+    //ParallelBuildResult: when a solution has at least min_outrecs paths (or
+    //PolyTree nodes), they're copied from the sweep's output on thread_cnt 
+    //threads (0: one per hardware thread). A min_outrecs of 0 (the default) 
+    //disables this.
+    void ParallelBuildResult(size_t min_outrecs, unsigned thread_cnt = 0)
+      { build_min_outrecs_ = min_outrecs; build_thread_cnt_ = thread_cnt; }
+    //SavePrepared & LoadPrepared: the added paths, once prepared for clipping
+    //(ie their vertices and sorted local minima), as a relocatable binary blob.
+    //LoadPrepared replaces any paths already added, but more can be added
+    //afterwards. The blob must come from a build with the same Point64, and
+    //LoadPrepared throws a ClipperException if it's malformed. (Descendants 
+    //that keep their own per-path data throw on LoadPrepared as that isn't
+    //in the blob.)
+    void SavePrepared(std::vector< char > &blob);
+    virtual void LoadPrepared(const char *blob, size_t size);
+#ifdef use_xyz
+    void ZFillFunction(ZFillCallback zfill_func) { zfill_func_ = zfill_func; }
+#endif
 };
 //------------------------------------------------------------------------------
 
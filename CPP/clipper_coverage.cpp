@@ -0,0 +1,227 @@
+/*******************************************************************************
+* Author    :  Angus Johnson                                                   *
+* Version   :  10.0 (beta)                                                     *
+* Date      :  8 November 2017                                                 *
+* Website   :  http://www.angusj.com                                           *
+* Copyright :  Angus Johnson 2010-2017                                         *
+* Purpose   :  Anti-aliased (exact area) coverage masks of clipping solutions  *
+* License   :  http://www.boost.org/LICENSE_1_0.txt                            *
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "clipper_coverage.h"
+#include "clipper_metrics.h"
+#include "clipper.h"
+
+namespace clipperlib {
+
+  //each worker thread resolves this many rows at a time ...
+  #define COVERAGE_CHUNK_ROWS (64)
+
+  template <typename T>
+  struct CoverageJob : public WorkerJob {
+    ClipperCoverage *owner;
+    const CoverageMask<T> *mask;
+  };
+
+  //------------------------------------------------------------------------------
+  // Miscellaneous functions ...
+  //------------------------------------------------------------------------------
+
+  inline void SetCoverage(float &pixel, float coverage) { pixel = coverage; }
+  //------------------------------------------------------------------------------
+
+  inline void SetCoverage(unsigned char &pixel, float coverage)
+  {
+    pixel = static_cast<unsigned char>(coverage * 255.0f + 0.5f);
+  }
+  //------------------------------------------------------------------------------
+
+  // ClipperCoverage methods ...
+  //------------------------------------------------------------------------------
+
+  void ClipperCoverage::BeginMask(size_t width, size_t height, const Rect64 &window)
+  {
+    width_ = width;
+    height_ = height;
+    window_ = window;
+    scale_x_ = double(width) / double(window.right - window.left);
+    scale_y_ = double(height) / double(window.bottom - window.top);
+    //nb: each row has 2 extra cells since edges at x == width_ spill over
+    accum_.assign((width + 2) * height, 0.0f);
+  }
+  //------------------------------------------------------------------------------
+
+  void ClipperCoverage::AccumulateLine(double x1, double y1, double x2, double y2, 
+    double dir)
+  {
+    //adds the signed area right of the line (where 0 <= x <= width_) to the
+    //cells that it passes through, and the rest to the cells on its right ...
+    if (y1 > y2) {
+      std::swap(x1, x2);
+      std::swap(y1, y2);
+    }
+    if (y2 <= 0 || y1 >= double(height_)) return;
+    double dxdy = (x2 - x1) / (y2 - y1);
+    double x = x1;
+    if (y1 < 0) {
+      x -= y1 * dxdy;
+      y1 = 0;
+    }
+    if (y2 > double(height_)) y2 = double(height_);
+    const size_t row_size = width_ + 2;
+    for (size_t row = size_t(y1); double(row) < y2; ++row) {
+      float *cells = &accum_[row * row_size];
+      double dy = std::min(double(row + 1), y2) - std::max(double(row), y1);
+      double x_next = std::min(std::max(x + dxdy * dy, 0.0), double(width_));
+      double d = dy * dir;
+      double xl = std::min(x, x_next), xr = std::max(x, x_next);
+      double xl_floor = std::floor(xl), xr_ceil = std::ceil(xr);
+      size_t xl_i = size_t(xl_floor), xr_i = size_t(xr_ceil);
+      if (xr_i <= xl_i + 1) {
+        //the line stays within a single cell
+        double x_mid = 0.5 * (x + x_next) - xl_floor;
+        cells[xl_i] += float(d - d * x_mid);
+        cells[xl_i + 1] += float(d * x_mid);
+      } else {
+        //the line crosses several cells, so split its area (a triangle at 
+        //either end and parallelograms in between) among them ...
+        double s = 1.0 / (xr - xl);
+        double xl_frac = xl - xl_floor;
+        double a0 = 0.5 * s * (1 - xl_frac) * (1 - xl_frac);
+        double xr_frac = xr - xr_ceil + 1;
+        double am = 0.5 * s * xr_frac * xr_frac;
+        cells[xl_i] += float(d * a0);
+        if (xr_i == xl_i + 2)
+          cells[xl_i + 1] += float(d * (1 - a0 - am));
+        else {
+          double a1 = s * (1.5 - xl_frac);
+          cells[xl_i + 1] += float(d * (a1 - a0));
+          for (size_t i = xl_i + 2; i < xr_i - 1; ++i) cells[i] += float(d * s);
+          double a2 = a1 + double(xr_i - xl_i - 3) * s;
+          cells[xr_i - 1] += float(d * (1 - a2 - am));
+        }
+        cells[xr_i] += float(d * am);
+      }
+      x = x_next;
+    }
+  }
+  //------------------------------------------------------------------------------
+
+  void ClipperCoverage::AccumulateEdge(double x1, double y1, double x2, double y2,
+    double dir)
+  {
+    //split the edge where it crosses the mask's left and right sides. Parts
+    //left of the mask still cover every pixel on their right, so they're moved
+    //onto x == 0, and parts right of the mask don't cover any (x == width_).
+    const double w = double(width_);
+    if (x1 > x2) {
+      std::swap(x1, x2);
+      std::swap(y1, y2);
+    }
+    if (x1 < 0) {
+      if (x2 <= 0) {
+        AccumulateLine(0, y1, 0, y2, dir);
+        return;
+      }
+      double y = y1 + (y2 - y1) * (0 - x1) / (x2 - x1);
+      AccumulateLine(0, y1, 0, y, dir);
+      x1 = 0;
+      y1 = y;
+    }
+    if (x2 > w) {
+      if (x1 >= w) {
+        AccumulateLine(w, y1, w, y2, dir);
+        return;
+      }
+      double y = y1 + (y2 - y1) * (w - x1) / (x2 - x1);
+      AccumulateLine(w, y, w, y2, dir);
+      x2 = w;
+      y2 = y;
+    }
+    AccumulateLine(x1, y1, x2, y2, dir);
+  }
+  //------------------------------------------------------------------------------
+
+  void ClipperCoverage::AddSolutionEdge(const Point64 &pt1, const Point64 &pt2, 
+    bool is_left_bound)
+  {
+    AccumulateEdge(
+      double(pt1.x - window_.left) * scale_x_, double(pt1.y - window_.top) * scale_y_,
+      double(pt2.x - window_.left) * scale_x_, double(pt2.y - window_.top) * scale_y_,
+      is_left_bound ? 1.0 : -1.0);
+  }
+  //------------------------------------------------------------------------------
+
+  template <typename T>
+  void ClipperCoverage::ResolveRows(const CoverageMask<T> &mask, size_t row1, size_t row2)
+  {
+    const size_t row_size = width_ + 2;
+    for (size_t row = row1; row < row2; ++row) {
+      const float *cells = &accum_[row * row_size];
+      T *pixels = mask.pixels + row * mask.stride;
+      float sum = 0;
+      for (size_t i = 0; i < width_; ++i) {
+        sum += cells[i];
+        float coverage = sum < 0 ? 0 : (sum > 1 ? 1 : sum);
+        SetCoverage(pixels[i], coverage);
+      }
+    }
+  }
+  //------------------------------------------------------------------------------
+
+  template <typename T>
+  void ClipperCoverage::ResolveWorker(WorkerJob *worker_job)
+  {
+    CoverageJob<T> *job = static_cast<CoverageJob<T>*>(worker_job);
+    ClipperCoverage &owner = *job->owner;
+    for (;;) {
+      size_t row = job->next.fetch_add(COVERAGE_CHUNK_ROWS);
+      if (row >= owner.height_ || job->failed) break;
+      owner.ResolveRows(*job->mask, row, std::min(row + COVERAGE_CHUNK_ROWS, owner.height_));
+    }
+  }
+  //------------------------------------------------------------------------------
+
+  template <typename T>
+  bool ClipperCoverage::ExecuteMask(ClipType clipType, const CoverageMask<T> &mask,
+    FillRule fr, unsigned thread_cnt)
+  {
+    if (!mask.width || !mask.height || mask.stride < mask.width ||
+      mask.window.right <= mask.window.left || mask.window.bottom <= mask.window.top)
+        throw ClipperException("ClipperCoverage: invalid mask.");
+    BeginMask(mask.width, mask.height, mask.window);
+    ClipMetrics metrics;
+    if (!ClipperMetrics::Execute(clipType, metrics, fr)) {
+      //ie there's nothing to clip, so the mask is empty
+      for (size_t row = 0; row < height_; ++row)
+        for (size_t i = 0; i < width_; ++i) SetCoverage(mask.pixels[row * mask.stride + i], 0);
+      return false;
+    }
+
+    CoverageJob<T> job;
+    job.owner = this;
+    job.mask = &mask;
+    RunWorkers(job, ResolveWorker<T>, thread_cnt, height_ / COVERAGE_CHUNK_ROWS);
+    return true;
+  }
+  //------------------------------------------------------------------------------
+
+  bool ClipperCoverage::Execute(ClipType clipType, const CoverageMask<float> &mask,
+    FillRule fr, unsigned thread_cnt)
+  {
+    return ExecuteMask(clipType, mask, fr, thread_cnt);
+  }
+  //------------------------------------------------------------------------------
+
+  bool ClipperCoverage::Execute(ClipType clipType, const CoverageMask<unsigned char> &mask,
+    FillRule fr, unsigned thread_cnt)
+  {
+    return ExecuteMask(clipType, mask, fr, thread_cnt);
+  }
+  //------------------------------------------------------------------------------
+
+} //namespace
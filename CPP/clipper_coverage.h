@@ -0,0 +1,73 @@
+/*******************************************************************************
+* Author    :  Angus Johnson                                                   *
+* Version   :  10.0 (beta)                                                     *
+* Date      :  8 November 2017                                                 *
+* Website   :  http://www.angusj.com                                           *
+* Copyright :  Angus Johnson 2010-2017                                         *
+* Purpose   :  Anti-aliased (exact area) coverage masks of clipping solutions  *
+* License   :  http://www.boost.org/LICENSE_1_0.txt                            *
+*******************************************************************************/
+
+#ifndef clipper_coverage_h
+#define clipper_coverage_h
+
+#include <vector>
+#include <cstdlib>
+#include "clipper.h"
+#include "clipper_metrics.h"
+
+namespace clipperlib {
+
+  //CoverageMask: a caller supplied buffer of height rows of width pixels, 
+  //where consecutive rows start stride pixels apart (so a mask can be a tile
+  //inside a larger image). window is the part of the path coordinate space 
+  //that's mapped onto the mask.
+  template <typename T>
+  struct CoverageMask {
+    T *pixels;
+    size_t width;
+    size_t height;
+    size_t stride;
+    Rect64 window;
+    CoverageMask(T *p, size_t w, size_t h, size_t s, const Rect64 &r): 
+      pixels(p), width(w), height(h), stride(s), window(r) {}
+  };
+
+  //ClipperCoverage: writes the fraction of each pixel that's covered by the 
+  //solution's filled region (from 0 to 1, or from 0 to 255 in 8-bit masks).
+  //The solution's edges are accumulated during the sweep (the way font 
+  //rasterizers accumulate signed areas) so the solution's paths are never 
+  //built, and the accumulated rows are then resolved by up to thread_cnt
+  //threads (0: one per hardware thread).
+  class ClipperCoverage : public ClipperMetrics
+  {
+  private:
+    std::vector< float > accum_;
+    size_t width_;
+    size_t height_;
+    Rect64 window_;
+    double scale_x_;
+    double scale_y_;
+    void BeginMask(size_t width, size_t height, const Rect64 &window);
+    void AccumulateLine(double x1, double y1, double x2, double y2, double dir);
+    void AccumulateEdge(double x1, double y1, double x2, double y2, double dir);
+    template <typename T> void ResolveRows(const CoverageMask<T> &mask, 
+      size_t row1, size_t row2);
+    template <typename T> static void ResolveWorker(WorkerJob *worker_job);
+    template <typename T> bool ExecuteMask(ClipType clipType, 
+      const CoverageMask<T> &mask, FillRule fr, unsigned thread_cnt);
+  protected:
+    void AddSolutionEdge(const Point64 &pt1, const Point64 &pt2, bool is_left_bound);
+  public:
+    explicit ClipperCoverage(MemoryResource *mr = NULL): Clipper(mr), 
+      ClipperMetrics(mr), width_(0), height_(0), window_(0, 0, 0, 0), 
+      scale_x_(0), scale_y_(0) {}
+    bool Execute(ClipType clipType, const CoverageMask<float> &mask, 
+      FillRule fr = frEvenOdd, unsigned thread_cnt = 0);
+    bool Execute(ClipType clipType, const CoverageMask<unsigned char> &mask, 
+      FillRule fr = frEvenOdd, unsigned thread_cnt = 0);
+  };
+
+} //namespace
+
+#endif //clipper_coverage_h
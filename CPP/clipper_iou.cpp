@@ -0,0 +1,245 @@
+/*******************************************************************************
+* Author    :  Angus Johnson                                                   *
+* Version   :  10.0 (beta)                                                     *
+* Date      :  8 November 2017                                                 *
+* Website   :  http://www.angusj.com                                           *
+* Copyright :  Angus Johnson 2010-2017                                         *
+* Purpose   :  Intersection over union (IoU), with a fast path for convex      *
+*              polygons (eg rotated boxes) and batched, multithreaded pairs    *
+* License   :  http://www.boost.org/LICENSE_1_0.txt                            *
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include "clipper_iou.h"
+#include "clipper.h"
+
+namespace clipperlib {
+
+  //ConvexIntersectArea clips one polygon by the other's edges in turn (ie
+  //Sutherland-Hodgman). Each clip returns at most two vertices per edge, so
+  //the buffers only move to the heap when that might not fit in IOU_STACK_PTS
+  //(and smaller polygons, eg boxes, are clipped without any allocation).
+  #define IOU_STACK_PTS (32)
+
+  //each worker thread takes this many pairs at a time (see BatchIoU) ...
+  #define IOU_CHUNK_SIZE (256)
+
+  struct PointD {
+    double x;
+    double y;
+  };
+
+  //------------------------------------------------------------------------------
+  // Miscellaneous functions ...
+  //------------------------------------------------------------------------------
+
+  static inline double CrossProduct(const Point64 &pt1, const Point64 &pt2, const Point64 &pt3)
+  {
+    return double(pt2.x - pt1.x) * double(pt3.y - pt2.y) -
+      double(pt2.y - pt1.y) * double(pt3.x - pt2.x);
+  }
+  //------------------------------------------------------------------------------
+
+  static double Area(const Path &path)
+  {
+    size_t cnt = path.size();
+    if (cnt < 3) return 0;
+    double a = 0;
+    for (size_t i = 0, j = cnt - 1; i < cnt; j = i, ++i)
+      a += (double(path[j].x) + double(path[i].x)) * (double(path[j].y) - double(path[i].y));
+    return a * 0.5;
+  }
+  //------------------------------------------------------------------------------
+
+  static double Area(const Paths &paths)
+  {
+    double a = 0;
+    for (Paths::const_iterator p = paths.begin(); p != paths.end(); ++p)
+      a += Area(*p);
+    return a;
+  }
+  //------------------------------------------------------------------------------
+
+  static double Area(const PointD *pts, size_t cnt)
+  {
+    if (cnt < 3) return 0;
+    double a = 0;
+    for (size_t i = 0, j = cnt - 1; i < cnt; j = i, ++i)
+      a += (pts[j].x + pts[i].x) * (pts[j].y - pts[i].y);
+    return a * 0.5;
+  }
+  //------------------------------------------------------------------------------
+
+  bool IsConvex(const Path &path)
+  {
+    size_t cnt = path.size();
+    if (cnt < 3) return false;
+    int turn_sign = 0, dy_sign = 0, dy_changes = 0;
+    for (size_t i = 0; i < cnt; ++i) {
+      const Point64 &pt1 = path[i], &pt2 = path[(i + 1) % cnt];
+      const Point64 &pt3 = path[(i + 2) % cnt];
+      double cp = CrossProduct(pt1, pt2, pt3);
+      if (cp != 0) {
+        int s = cp > 0 ? 1 : -1;
+        if (!turn_sign) turn_sign = s;
+        else if (s != turn_sign) return false;
+      }
+      //collinear edges must also keep going the same way (not double back) ...
+      else if (double(pt2.x - pt1.x) * double(pt3.x - pt2.x) + 
+        double(pt2.y - pt1.y) * double(pt3.y - pt2.y) < 0) return false;
+      //a convex polygon only changes vertical direction twice, whereas 
+      //'star' polygons (that turn one way but wind more than once) do so more
+      if (pt2.y == pt1.y) continue;
+      int s = pt2.y > pt1.y ? 1 : -1;
+      if (dy_sign && s != dy_sign) ++dy_changes;
+      dy_sign = s;
+    }
+    return turn_sign && dy_changes <= 2;
+  }
+  //------------------------------------------------------------------------------
+
+  static size_t ClipByEdge(const PointD *pts, size_t cnt, const PointD &a, const PointD &b, 
+    double sign, PointD *result)
+  {
+    //keeps the part of pts that's on the inside (ie left when sign > 0) of a->b
+    //nb: result must have room for cnt * 2 points
+    size_t result_cnt = 0;
+    if (!cnt) return 0;
+    double dx = b.x - a.x, dy = b.y - a.y;
+    const PointD *prev = &pts[cnt - 1];
+    double prev_d = sign * (dx * (prev->y - a.y) - dy * (prev->x - a.x));
+    for (size_t i = 0; i < cnt; ++i) {
+      const PointD *curr = &pts[i];
+      double curr_d = sign * (dx * (curr->y - a.y) - dy * (curr->x - a.x));
+      if ((curr_d >= 0) != (prev_d >= 0)) {
+        double t = prev_d / (prev_d - curr_d);
+        PointD &ip = result[result_cnt++];
+        ip.x = prev->x + (curr->x - prev->x) * t;
+        ip.y = prev->y + (curr->y - prev->y) * t;
+      }
+      if (curr_d >= 0) result[result_cnt++] = *curr;
+      prev = curr;
+      prev_d = curr_d;
+    }
+    return result_cnt;
+  }
+  //------------------------------------------------------------------------------
+
+  double ConvexIntersectArea(const Path &path1, const Path &path2)
+  {
+    size_t cnt1 = path1.size(), cnt2 = path2.size();
+    if (cnt1 < 3 || cnt2 < 3) return 0;
+    double sign = Area(path2) < 0 ? 1 : -1;
+
+    size_t buff_size = IOU_STACK_PTS;
+    PointD stack_buff[IOU_STACK_PTS * 2];
+    std::vector< PointD > heap_buff;
+    PointD *buff1 = stack_buff, *buff2 = stack_buff + IOU_STACK_PTS;
+    if (cnt1 > buff_size) {
+      buff_size = cnt1 * 2;
+      heap_buff.resize(buff_size * 2);
+      buff1 = &heap_buff[0];
+      buff2 = buff1 + buff_size;
+    }
+
+    for (size_t i = 0; i < cnt1; ++i) {
+      buff1[i].x = double(path1[i].x);
+      buff1[i].y = double(path1[i].y);
+    }
+    size_t cnt = cnt1;
+    PointD a, b;
+    a.x = double(path2[cnt2 - 1].x);
+    a.y = double(path2[cnt2 - 1].y);
+    for (size_t i = 0; i < cnt2 && cnt; ++i) {
+      b.x = double(path2[i].x);
+      b.y = double(path2[i].y);
+      if (cnt * 2 > buff_size) {
+        //make room for the most points this clip could return ...
+        buff_size = cnt * 2;
+        std::vector< PointD > new_buff(buff_size * 2);
+        std::copy(buff1, buff1 + cnt, new_buff.begin());
+        heap_buff.swap(new_buff);
+        buff1 = &heap_buff[0];
+        buff2 = buff1 + buff_size;
+      }
+      cnt = ClipByEdge(buff1, cnt, a, b, sign, buff2);
+      std::swap(buff1, buff2);
+      a = b;
+    }
+    return std::fabs(Area(buff1, cnt));
+  }
+  //------------------------------------------------------------------------------
+
+  double IoU(const Path &path1, const Path &path2)
+  {
+    double intersect_area, union_area;
+    if (IsConvex(path1) && IsConvex(path2)) {
+      intersect_area = ConvexIntersectArea(path1, path2);
+      union_area = std::fabs(Area(path1)) + std::fabs(Area(path2)) - intersect_area;
+    } else {
+      //nb: self-intersecting paths aren't simple so union_area must also come
+      //from Clipper rather than from the areas of the two paths ...
+      Paths sol;
+      Clipper c;
+      c.AddPath(path1, ptSubject);
+      c.AddPath(path2, ptClip);
+      c.Execute(ctIntersection, sol, frNonZero);
+      intersect_area = std::fabs(Area(sol));
+      c.Execute(ctUnion, sol, frNonZero);
+      union_area = std::fabs(Area(sol));
+    }
+    return union_area > 0 ? intersect_area / union_area : 0;
+  }
+  //------------------------------------------------------------------------------
+
+  struct IoUJob : public WorkerJob {
+    const Paths *paths1;
+    const Paths *paths2;
+    const PathPairs *pairs;
+    std::vector< double > *results;
+  };
+  //------------------------------------------------------------------------------
+
+  static void IoUWorker(WorkerJob *worker_job)
+  {
+    IoUJob *job = static_cast<IoUJob*>(worker_job);
+    const PathPairs &pairs = *job->pairs;
+    for (;;) {
+      size_t start = job->next.fetch_add(IOU_CHUNK_SIZE);
+      if (start >= pairs.size() || job->failed) break;
+      size_t end = std::min(start + IOU_CHUNK_SIZE, pairs.size());
+      for (size_t i = start; i < end; ++i)
+        (*job->results)[i] = IoU((*job->paths1)[pairs[i].idx1], 
+          (*job->paths2)[pairs[i].idx2]);
+    }
+  }
+  //------------------------------------------------------------------------------
+
+  void BatchIoU(const Paths &paths1, const Paths &paths2, const PathPairs &pairs,
+    std::vector< double > &results, unsigned thread_cnt)
+  {
+    results.resize(pairs.size());
+    for (PathPairs::const_iterator p = pairs.begin(); p != pairs.end(); ++p)
+      if (p->idx1 >= paths1.size() || p->idx2 >= paths2.size())
+        throw ClipperException("BatchIoU: path index out of range");
+
+    IoUJob job;
+    job.paths1 = &paths1;
+    job.paths2 = &paths2;
+    job.pairs = &pairs;
+    job.results = &results;
+    //don't bother with threads for small batches ...
+    try {
+      RunWorkers(job, IoUWorker, thread_cnt, pairs.size() / IOU_CHUNK_SIZE);
+    }
+    catch (...) {
+      results.clear();
+      throw;
+    }
+  }
+  //------------------------------------------------------------------------------
+
+} //namespace
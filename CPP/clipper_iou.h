@@ -0,0 +1,49 @@
+/*******************************************************************************
+* Author    :  Angus Johnson                                                   *
+* Version   :  10.0 (beta)                                                     *
+* Date      :  8 November 2017                                                 *
+* Website   :  http://www.angusj.com                                           *
+* Copyright :  Angus Johnson 2010-2017                                         *
+* Purpose   :  Intersection over union (IoU), with a fast path for convex      *
+*              polygons (eg rotated boxes) and batched, multithreaded pairs    *
+* License   :  http://www.boost.org/LICENSE_1_0.txt                            *
+*******************************************************************************/
+
+#ifndef clipper_iou_h
+#define clipper_iou_h
+
+#include <vector>
+#include <cstdlib>
+#include "clipper.h"
+
+namespace clipperlib {
+
+  struct PathPair {
+    size_t idx1; //index into paths1
+    size_t idx2; //index into paths2
+    PathPair(size_t i1 = 0, size_t i2 = 0): idx1(i1), idx2(i2) {}
+  };
+
+  typedef std::vector< PathPair > PathPairs;
+
+  //IsConvex: true when path is a convex polygon (collinear vertices allowed,
+  //but not edges that double back over the previous one).
+  bool IsConvex(const Path &path);
+
+  //ConvexIntersectArea: the area of the intersection of two convex polygons of
+  //either orientation. Both paths must be convex (see IsConvex).
+  double ConvexIntersectArea(const Path &path1, const Path &path2);
+
+  //IoU: intersection area / union area of two polygons (or 0 when the union is
+  //empty). Convex polygons use ConvexIntersectArea, and other polygons fall 
+  //back to Clipper (with the NonZero fill rule).
+  double IoU(const Path &path1, const Path &path2);
+
+  //BatchIoU: IoU for each pair of paths1[pair.idx1] and paths2[pair.idx2], 
+  //shared among thread_cnt threads (0: one per hardware thread).
+  void BatchIoU(const Paths &paths1, const Paths &paths2, const PathPairs &pairs,
+    std::vector< double > &results, unsigned thread_cnt = 0);
+
+} //namespace
+
+#endif //clipper_iou_h
@@ -0,0 +1,214 @@
+/*******************************************************************************
+* Author    :  Angus Johnson                                                   *
+* Version   :  10.0 (beta)                                                     *
+* Date      :  8 November 2017                                                 *
+* Website   :  http://www.angusj.com                                           *
+* Copyright :  Angus Johnson 2010-2017                                         *
+* Purpose   :  Area, bounds & count of clipping solutions (without the paths)  *
+* License   :  http://www.boost.org/LICENSE_1_0.txt                            *
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <limits>
+#include <new>
+#include "clipper_metrics.h"
+#include "clipper.h"
+
+namespace clipperlib {
+
+  //------------------------------------------------------------------------------
+  // Miscellaneous functions ...
+  //------------------------------------------------------------------------------
+
+  inline bool IsOpen(const Active &e) { return e.is_open; }
+  //------------------------------------------------------------------------------
+
+  inline bool IsStartSide(const Active &e) { return (&e == e.outrec->start_e); }
+  //------------------------------------------------------------------------------
+
+  inline Point64& GetSidePt(Active &e)
+  {
+    OutRecMetrics *outrec = static_cast<OutRecMetrics *>(e.outrec);
+    return IsStartSide(e) ? outrec->start_pt : outrec->end_pt;
+  }
+  //------------------------------------------------------------------------------
+
+  inline Point64 GetEdgePt(const OutRecMetrics &outrec, const Active *e)
+  {
+    return (e == outrec.start_e) ? outrec.start_pt : outrec.end_pt;
+  }
+  //------------------------------------------------------------------------------
+
+  inline void AddToBounds(Rect64 &r, const Point64 &pt)
+  {
+    if (pt.x < r.left) r.left = pt.x;
+    if (pt.x > r.right) r.right = pt.x;
+    if (pt.y < r.top) r.top = pt.y;
+    if (pt.y > r.bottom) r.bottom = pt.y;
+  }
+  //------------------------------------------------------------------------------
+
+  inline void AddToBounds(Rect64 &r, const Rect64 &r2)
+  {
+    if (r2.left < r.left) r.left = r2.left;
+    if (r2.right > r.right) r.right = r2.right;
+    if (r2.top < r.top) r.top = r2.top;
+    if (r2.bottom > r.bottom) r.bottom = r2.bottom;
+  }
+  //------------------------------------------------------------------------------
+
+  //------------------------------------------------------------------------------
+  // ClipperMetrics methods ...
+  //------------------------------------------------------------------------------
+
+  void ClipperMetrics::AddSegment(Active &e, const Point64 &pt)
+  {
+    //the sweep ascends (ie Y decreases), so dy >= 0 and the region between a
+    //left bound and a right bound is sum(x_right - x_left) * dy. (Left bounds
+    //are usually start_e edges, but that's not always so until paths join.)
+    //Which side is the left bound only changes when paths join, so it's only
+    //found (by counting hot edges in the AEL) once per path and join ...
+    Point64 &prev_pt = GetSidePt(e);
+    if (prev_pt.y != pt.y) {
+      OutRecMetrics *outrec = static_cast<OutRecMetrics *>(e.outrec);
+      if (outrec->start_is_left < 0)
+        outrec->start_is_left = (IsLeftBound(e) == IsStartSide(e)) ? 1 : 0;
+      AddSolutionEdge(prev_pt, pt, IsStartSide(e) == (outrec->start_is_left == 1));
+    }
+    prev_pt = pt;
+  }
+  //------------------------------------------------------------------------------
+
+  void ClipperMetrics::AddSolutionEdge(const Point64 &pt1, const Point64 &pt2, 
+    bool is_left_bound)
+  {
+    double a = (double(pt1.x) + double(pt2.x)) * double(pt1.y - pt2.y) * 0.5;
+    if (is_left_bound) metrics_.area -= a; else metrics_.area += a;
+  }
+  //------------------------------------------------------------------------------
+
+  OutPt* ClipperMetrics::CreateOutPt()
+  {
+    //paths are never built, so every OutRec shares the one (self-linked) OutPt
+    dummy_op_.next = &dummy_op_;
+    dummy_op_.prev = &dummy_op_;
+    return &dummy_op_;
+  }
+  //------------------------------------------------------------------------------
+
+  OutRec* ClipperMetrics::CreateOutRec()
+  {
+    return new (outrec_arena_.Alloc()) OutRecMetrics();
+  }
+  //------------------------------------------------------------------------------
+
+  OutPt* ClipperMetrics::AddOutPt(Active &e, const Point64 pt)
+  {
+    if (IsOpen(e)) return &dummy_op_;
+    if (pt == GetSidePt(e)) return &dummy_op_;
+    AddSegment(e, pt);
+    OutRecMetrics *outrec = static_cast<OutRecMetrics *>(e.outrec);
+    outrec->pt_cnt++;
+    AddToBounds(outrec->bounds, pt);
+    return &dummy_op_;
+  }
+  //------------------------------------------------------------------------------
+
+  void ClipperMetrics::AddLocalMinPoly(Active &e1, Active &e2, const Point64 pt)
+  {
+    Clipper::AddLocalMinPoly(e1, e2, pt);
+    if (IsOpen(e1)) return;
+    OutRecMetrics *outrec = static_cast<OutRecMetrics *>(e1.outrec);
+    outrec->start_pt = pt;
+    outrec->end_pt = pt;
+    outrec->pt_cnt = 1;
+    outrec->bounds = Rect64(pt.x, pt.y, pt.x, pt.y);
+    outrec->start_is_left = -1;
+  }
+  //------------------------------------------------------------------------------
+
+  void ClipperMetrics::AddLocalMaxPoly(Active &e1, Active &e2, const Point64 pt)
+  {
+    if (IsOpen(e1)) {
+      Clipper::AddLocalMaxPoly(e1, e2, pt);
+      return;
+    }
+    //nb: e2's last segment also ends at pt (where it meets e1) ...
+    OutRecMetrics *or1 = static_cast<OutRecMetrics *>(e1.outrec);
+    OutRecMetrics *or2 = static_cast<OutRecMetrics *>(e2.outrec);
+    if (!or2) {
+      Clipper::AddLocalMaxPoly(e1, e2, pt); //throws an exception
+      return;
+    }
+    bool is_dup_end = (GetSidePt(e2) == pt);
+    AddSegment(e2, pt);
+    if (or1 == or2) {
+      Clipper::AddLocalMaxPoly(e1, e2, pt);
+      //the path is now closed, so count it (unless it's degenerate) ...
+      size_t cnt = or1->pt_cnt;
+      if (is_dup_end) cnt--;
+      if (cnt < 3) return;
+      metrics_.count++;
+      AddToBounds(metrics_.bounds, or1->bounds);
+      return;
+    }
+
+    //e1 and e2 belong to different paths that are about to be joined, and the
+    //joined path continues with the other (ie non-maxima) edge of each path ...
+    Active *e1_other = (or1->start_e == &e1) ? or1->end_e : or1->start_e;
+    Active *e2_other = (or2->start_e == &e2) ? or2->end_e : or2->start_e;
+    Point64 e1_other_pt = GetEdgePt(*or1, e1_other);
+    Point64 e2_other_pt = GetEdgePt(*or2, e2_other);
+    Clipper::AddLocalMaxPoly(e1, e2, pt); //nb: this also calls AddOutPt(e1, pt)
+    OutRecMetrics *outrec = or1->pts ? or1 : or2;
+    if (outrec->start_e == e1_other) outrec->start_pt = e1_other_pt;
+    else if (outrec->start_e == e2_other) outrec->start_pt = e2_other_pt;
+    if (outrec->end_e == e1_other) outrec->end_pt = e1_other_pt;
+    else if (outrec->end_e == e2_other) outrec->end_pt = e2_other_pt;
+    outrec->pt_cnt = or1->pt_cnt + or2->pt_cnt;
+    AddToBounds(outrec->bounds, outrec == or1 ? or2->bounds : or1->bounds);
+    outrec->start_is_left = -1;
+  }
+  //------------------------------------------------------------------------------
+
+  bool ClipperMetrics::Execute(ClipType clipType, ClipMetrics &metrics, FillRule fr)
+  {
+    metrics = ClipMetrics();
+    metrics_ = ClipMetrics();
+    const int64_t hi = std::numeric_limits<int64_t>::max();
+    const int64_t lo = std::numeric_limits<int64_t>::min();
+    metrics_.bounds = Rect64(hi, hi, lo, lo);
+    bool result = ExecuteInternal(clipType, fr);
+    if (result) {
+      if (metrics_.bounds.left > metrics_.bounds.right) 
+        metrics_.bounds = Rect64(0, 0, 0, 0);
+      metrics = metrics_;
+    }
+    CleanUp();
+    outrec_arena_.Clear();
+    return result;
+  }
+  //------------------------------------------------------------------------------
+
+  bool ClipperMetrics::Execute(ClipType /*clipType*/, Paths &/*solution_closed*/, 
+    FillRule /*fr*/)
+  {
+    throw ClipperException("ClipperMetrics: use Clipper for the solution's paths.");
+  }
+  //------------------------------------------------------------------------------
+
+  bool ClipperMetrics::Execute(ClipType /*clipType*/, Paths &/*solution_closed*/, 
+    Paths &/*solution_open*/, FillRule /*fr*/)
+  {
+    throw ClipperException("ClipperMetrics: use Clipper for the solution's paths.");
+  }
+  //------------------------------------------------------------------------------
+
+  bool ClipperMetrics::Execute(ClipType /*clipType*/, PolyTree &/*solution_closed*/, 
+    Paths &/*solution_open*/, FillRule /*fr*/)
+  {
+    throw ClipperException("ClipperMetrics: use Clipper for the solution's paths.");
+  }
+  //------------------------------------------------------------------------------
+
+} //namespace
@@ -0,0 +1,74 @@
+/*******************************************************************************
+* Author    :  Angus Johnson                                                   *
+* Version   :  10.0 (beta)                                                     *
+* Date      :  8 November 2017                                                 *
+* Website   :  http://www.angusj.com                                           *
+* Copyright :  Angus Johnson 2010-2017                                         *
+* Purpose   :  Area, bounds & count of clipping solutions (without the paths)  *
+* License   :  http://www.boost.org/LICENSE_1_0.txt                            *
+*******************************************************************************/
+
+#ifndef clipper_metrics_h
+#define clipper_metrics_h
+
+#include <cstdlib>
+#include "clipper.h"
+
+namespace clipperlib {
+
+  struct ClipMetrics {
+    double area;   //total filled area (ie outers less holes)
+    Rect64 bounds; //bounds of every solution vertex (all 0 when empty)
+    size_t count;  //number of closed paths (outers and holes)
+    ClipMetrics(): area(0), bounds(0, 0, 0, 0), count(0) {}
+  };
+
+  //OutRecMetrics: only the last vertex on each side of the path is kept,
+  //together with the path's vertex count and bounds.
+  class OutRecMetrics : public OutRec
+  {
+  public:
+    Point64 start_pt;
+    Point64 end_pt;
+    size_t  pt_cnt;
+    Rect64  bounds;
+    int     start_is_left; //whether start_e is a left bound (-1: not known yet)
+    OutRecMetrics(): pt_cnt(0), bounds(0, 0, 0, 0), start_is_left(-1) {}
+  };
+
+  //ClipperMetrics: accumulates the area, bounds and path count of a clipping
+  //solution during the sweep without ever building the solution's paths.
+  //Area is the sum of each solution edge's trapezoid (x * dy), signed by whether
+  //the edge is a left or right bound, so holes are handled without needing to
+  //know how the solution's edges eventually join.
+  class ClipperMetrics : public virtual Clipper
+  {
+  private:
+    OutPt dummy_op_;
+    ClipMetrics metrics_;
+    MemArena outrec_arena_;
+    void AddSegment(Active &e, const Point64 &pt);
+  protected:
+    //AddSolutionEdge: called for every (non-horizontal) edge in the solution.
+    //Left bounds have the solution's filled region on their right.
+    virtual void AddSolutionEdge(const Point64 &pt1, const Point64 &pt2, bool is_left_bound);
+    OutPt* CreateOutPt();
+    OutRec* CreateOutRec();
+    OutPt* AddOutPt(Active &e, const Point64 pt);
+    void AddLocalMinPoly(Active &e1, Active &e2, const Point64 pt);
+    void AddLocalMaxPoly(Active &e1, Active &e2, const Point64 pt);
+  public:
+    explicit ClipperMetrics(MemoryResource *mr = NULL) : Clipper(mr), 
+      outrec_arena_(sizeof(OutRecMetrics), mr) {}
+    bool Execute(ClipType clipType, ClipMetrics &metrics, FillRule fr = frEvenOdd);
+    //these throw since the solution's paths are never built (use Clipper) ...
+    bool Execute(ClipType clipType, Paths &solution_closed, FillRule fr = frEvenOdd);
+    bool Execute(ClipType clipType, Paths &solution_closed, Paths &solution_open, 
+      FillRule fr = frEvenOdd);
+    bool Execute(ClipType clipType, PolyTree &solution_closed, Paths &solution_open, 
+      FillRule fr = frEvenOdd);
+  };
+
+} //namespace
+
+#endif //clipper_metrics_h
@@ -13,8 +13,10 @@
 #include <cstdlib>
 #include <cmath>
 #include <algorithm>
+#include <new>
 #include "clipper.h"
 #include "clipper_offset.h"
+#include "clipper_triangulation.h"
 
 namespace clipperlib {
 
@@ -22,6 +24,21 @@ namespace clipperlib {
   #define TWO_PI            (PI * 2)
   #define DEFAULT_ARC_FRAC  (0.02)
   #define TOLERANCE         (1.0E-12)
+  #define OFFSET_CHUNK_SIZE (64)  //paths offset at a time by each worker thread
+
+  struct ClipperOffset::OffsetJob : public WorkerJob {
+    const ClipperOffset *owner;
+    double delta;
+    bool negate;
+    PathsList chunks;  //the offset paths, OFFSET_CHUNK_SIZE nodes per chunk
+  };
+
+  struct ClipperOffset::GroupJob : public WorkerJob {
+    const ClipperOffset *owner;
+    double delta;
+    std::vector< NodeList > groups;
+    PathsList *sols;
+  };
 
   inline int64_t Round(double val)
   {
@@ -56,10 +73,12 @@ namespace clipperlib {
   }
   //---------------------------------------------------------------------------
 
-  ClipperOffset::PathNode::PathNode(const Path &p, JoinType jt, EndType et)
+  ClipperOffset::PathNode::PathNode(const Path &p, JoinType jt, EndType et,
+    const std::vector< double > *vertex_deltas)
   {
     join_type = jt;
     end_type = et;
+    oriented = false;
 
     size_t len_path = p.size();
     if (et == kPolygon || et == kOpenJoined)
@@ -76,6 +95,11 @@ namespace clipperlib {
 
     path.reserve(len_path);
     path.push_back(p[0]);
+    //vertex deltas are kept in step with the (de-duplicated) vertices ...
+    if (vertex_deltas) {
+      deltas.reserve(len_path);
+      deltas.push_back((*vertex_deltas)[0]);
+    }
 
     Point64 last_pt = p[0];
     lowest_idx = 0;
@@ -84,6 +108,7 @@ namespace clipperlib {
       if (last_pt == p[i]) continue;
       last++; 
       path.push_back(p[i]);
+      if (vertex_deltas) deltas.push_back((*vertex_deltas)[i]);
       last_pt = p[i];
       //j == path.size() -1;
       if (et != kPolygon) continue;
@@ -91,7 +116,14 @@ namespace clipperlib {
         (path[last].y > path[lowest_idx].y || path[last].x < path[lowest_idx].x))
         lowest_idx = last;
     }
-    if (end_type == kPolygon && path.size() < 3) path.clear();
+    if (end_type == kPolygon && path.size() < 3) {
+      path.clear();
+      deltas.clear();
+    }
+    //and when the vertex deltas are all the same, they're just a path delta ...
+    else if (deltas.size() > 1 && 
+      std::count(deltas.begin(), deltas.end(), deltas[0]) == (int)deltas.size())
+      deltas.resize(1);
   }
   //---------------------------------------------------------------------------
 
@@ -102,7 +134,7 @@ namespace clipperlib {
     for (size_t i = 0; i < nodes_.size(); ++i)
     {
       PathNode *node = nodes_[i];
-      if (node->end_type != kPolygon) continue;
+      if (node->end_type != kPolygon || node->oriented) continue;
       if (lowest_idx_ < 0)
       {
         ip1 = node->path[node->lowest_idx];
@@ -121,8 +153,15 @@ namespace clipperlib {
   }
   //---------------------------------------------------------------------------
 
+  void ClipperOffset::SetVertexDelta(size_t j)
+  {
+    if (vertex_deltas_) UseDelta((*vertex_deltas_)[j] * delta_sign_);
+  }
+  //---------------------------------------------------------------------------
+
   void ClipperOffset::OffsetPoint(size_t j, size_t &k, JoinType join_type)
   {
+    SetVertexDelta(j);
     //A: angle between adjoining paths on left side (left WRT winding direction).
     //A == 0 deg (or A == 360 deg): collinear edges heading in same direction
     //A == 180 deg: collinear edges heading in opposite directions (ie a 'spike')
@@ -240,197 +279,322 @@ namespace clipperlib {
   }
   //---------------------------------------------------------------------------
 
-  void ClipperOffset::DoOffset(double d)
+  void ClipperOffset::SetOffsetParams(double d)
   {
     delta_ = d;
     double abs_delta = fabs(d);
-
-    //if a Zero offset, then just copy CLOSED polygons to FSolution and return ...
-    if (abs_delta < TOLERANCE)
-    {
-      solution_.reserve(nodes_.size());
-      for (NodeList::iterator nl_iter = nodes_.begin(); nl_iter != nodes_.end(); ++nl_iter)
-        if ((*nl_iter)->end_type == kPolygon) solution_.push_back((*nl_iter)->path);
-      return;
-    }
-
     //MiterLimit: see offset_triginometry3.svg in the documentation folder ...
     if (miter_limit_ > 2)
       miter_lim_ = 2 / (miter_limit_ * miter_limit_);
     else
       miter_lim_ = 0.5;
 
+    if (abs_delta < TOLERANCE) {
+      //eg where a vertex delta tapers to nothing ...
+      steps_ = 1;
+      sin_ = 0;
+      cos_ = 1;
+      steps_per_radian_ = 0;
+      return;
+    }
+
     double arc_tol;
     if (arc_tolerance_ < DEFAULT_ARC_FRAC)
       arc_tol = abs_delta * DEFAULT_ARC_FRAC; else
       arc_tol = arc_tolerance_;
 
     //see offset_triginometry2.svg in the documentation folder ...
-    double steps = PI / acos(1 - arc_tol / abs_delta);  //steps per 360 degrees
-    if (steps > abs_delta * PI) steps = abs_delta * PI; //ie excessive precision check
+    steps_ = PI / acos(1 - arc_tol / abs_delta);  //steps per 360 degrees
+    if (steps_ > abs_delta * PI) steps_ = abs_delta * PI; //ie excessive precision check
 
-    sin_ = sin(TWO_PI / steps);
-    cos_ = cos(TWO_PI / steps);
+    sin_ = sin(TWO_PI / steps_);
+    cos_ = cos(TWO_PI / steps_);
     if (d < 0) sin_ = -sin_;
-    steps_per_radian_ = steps / TWO_PI;
+    steps_per_radian_ = steps_ / TWO_PI;
+  }
+  //---------------------------------------------------------------------------
 
+  void ClipperOffset::DoOffset(double d, bool negate)
+  {
+    delta_sign_ = negate ? -1 : 1;
+    base_delta_ = d;
+    SetOffsetParams(d);
     solution_.reserve(nodes_.size() * 2);
     for (NodeList::iterator nl_iter = nodes_.begin(); nl_iter != nodes_.end(); ++nl_iter)
-    {
-      PathNode *node = *nl_iter;
-      path_in_ = node->path;
-      path_out_.clear();
-      size_t path_in_size = path_in_.size();
+      OffsetNode(**nl_iter);
+    norms_.clear();
+    path_in_.clear();
+    path_out_.clear();
+  }
+  //---------------------------------------------------------------------------
 
-      //if a single vertex then build circle or a square ...
-      if (path_in_size == 1)
+  void ClipperOffset::OffsetNode(const PathNode &node)
+  {
+    //oriented nodes (see AddPolyTree) keep their delta when the other paths
+    //are negated (see Execute), and their offsets are reversed instead so they
+    //suit the union's fill rule ...
+    bool reverse = node.oriented && delta_sign_ < 0;
+
+    //if a Zero offset, then just copy CLOSED polygons to FSolution and return ...
+    vertex_deltas_ = NULL;
+    if (node.deltas.size() > 1) vertex_deltas_ = &node.deltas;
+    else
+    {
+      double d = node.deltas.empty() ? base_delta_ : node.deltas[0] * delta_sign_;
+      if (reverse) d = -d;
+      if (fabs(d) < TOLERANCE)
       {
-        if (node->join_type == kRound)
+        if (node.end_type == kPolygon)
         {
-          double x = 1.0, y = 0.0;
-          for (int j = 1; j <= steps; j++)
-          {
-            path_out_.push_back(Point64(
-              Round(path_in_[0].x + x * delta_),
-              Round(path_in_[0].y + y * delta_)));
-            double x2 = x;
-            x = x * cos_ - sin_ * y;
-            y = x2 * sin_ + y * cos_;
-          }
+          solution_.push_back(node.path);
+          if (reverse) std::reverse(solution_.back().begin(), solution_.back().end());
         }
-        else
+        return;
+      }
+      UseDelta(d);
+    }
+
+    path_in_ = node.path;
+    path_out_.clear();
+    size_t path_in_size = path_in_.size();
+
+    //if a single vertex then build circle or a square ...
+    if (path_in_size == 1)
+    {
+      if (node.join_type == kRound)
+      {
+        double x = 1.0, y = 0.0;
+        for (int j = 1; j <= steps_; j++)
         {
-          double x = -1.0, y = -1.0;
-          for (int j = 0; j < 4; ++j)
-          {
-            path_out_.push_back(Point64(
-              Round(path_in_[0].x + x * delta_),
-              Round(path_in_[0].y + y * delta_)));
-            if (x < 0) x = 1;
-            else if (y < 0) y = 1;
-            else x = -1;
-          }
+          path_out_.push_back(Point64(
+            Round(path_in_[0].x + x * delta_),
+            Round(path_in_[0].y + y * delta_)));
+          double x2 = x;
+          x = x * cos_ - sin_ * y;
+          y = x2 * sin_ + y * cos_;
         }
-        solution_.push_back(path_out_);
-        continue;
-      } //end of single vertex offsetting
-
-        //build norms_ ...
-      norms_.clear();
-      norms_.reserve(path_in_size);
-      for (size_t j = 0; j < path_in_size - 1; ++j)
-        norms_.push_back(GetUnitNormal(path_in_[j], path_in_[j + 1]));
-      if (node->end_type == kOpenJoined || node->end_type == kPolygon)
-        norms_.push_back(GetUnitNormal(path_in_[path_in_size - 1], path_in_[0]));
+      }
       else
-        norms_.push_back(PointD(norms_[path_in_size - 2]));
-
-      if (node->end_type == kPolygon)
       {
-        size_t k = path_in_size - 1;
-        for (size_t j = 0; j < path_in_size; j++)
-          OffsetPoint(j, k, node->join_type);
-        solution_.push_back(path_out_);
+        double x = -1.0, y = -1.0;
+        for (int j = 0; j < 4; ++j)
+        {
+          path_out_.push_back(Point64(
+            Round(path_in_[0].x + x * delta_),
+            Round(path_in_[0].y + y * delta_)));
+          if (x < 0) x = 1;
+          else if (y < 0) y = 1;
+          else x = -1;
+        }
       }
-      else if (node->end_type == kOpenJoined)
+      solution_.push_back(path_out_);
+      return;
+    } //end of single vertex offsetting
+
+    //build norms_ ...
+    norms_.clear();
+    norms_.reserve(path_in_size);
+    for (size_t j = 0; j < path_in_size - 1; ++j)
+      norms_.push_back(GetUnitNormal(path_in_[j], path_in_[j + 1]));
+    if (node.end_type == kOpenJoined || node.end_type == kPolygon)
+      norms_.push_back(GetUnitNormal(path_in_[path_in_size - 1], path_in_[0]));
+    else
+      norms_.push_back(PointD(norms_[path_in_size - 2]));
+
+    if (node.end_type == kPolygon)
+    {
+      size_t k = path_in_size - 1;
+      for (size_t j = 0; j < path_in_size; j++)
+        OffsetPoint(j, k, node.join_type);
+      if (reverse) std::reverse(path_out_.begin(), path_out_.end());
+      solution_.push_back(path_out_);
+    }
+    else if (node.end_type == kOpenJoined)
+    {
+      size_t k = path_in_size - 1;
+      for (size_t j = 0; j < path_in_size; j++)
+        OffsetPoint(j, k, node.join_type);
+      solution_.push_back(path_out_);
+      path_out_.clear();
+      //re-build norms_ ...
+      PointD n = norms_[path_in_size - 1];
+      for (size_t j = path_in_size - 1; j > 0; --j)
+        norms_[j] = PointD(-norms_[j - 1].x, -norms_[j - 1].y);
+      norms_[0] = PointD(-n.x, -n.y);
+      k = 0;
+      for (size_t j = path_in_size; j > 0; j--)
+        OffsetPoint(j-1, k, node.join_type);
+      solution_.push_back(path_out_);
+    }
+    else
+    {
+      size_t k = 0;
+      for (size_t j = 1; j < path_in_size - 1; ++j)
+        OffsetPoint(j, k, node.join_type);
+
+      Point64 pt1;
+      SetVertexDelta(path_in_size - 1);
+      if (node.end_type == kOpenButt)
       {
-        size_t k = path_in_size - 1;
-        for (size_t j = 0; j < path_in_size; j++)
-          OffsetPoint(j, k, node->join_type);
-        solution_.push_back(path_out_);
-        path_out_.clear();
-        //re-build norms_ ...
-        PointD n = norms_[path_in_size - 1];
-        for (size_t j = path_in_size - 1; j > 0; --j)
-          norms_[j] = PointD(-norms_[j - 1].x, -norms_[j - 1].y);
-        norms_[0] = PointD(-n.x, -n.y);
-        k = 0;
-        for (size_t j = path_in_size; j > 0; j--)
-          OffsetPoint(j-1, k, node->join_type);
-        solution_.push_back(path_out_);
+        size_t j = path_in_size - 1;
+        pt1 = Point64(Round(path_in_[j].x + norms_[j].x *
+          delta_), Round(path_in_[j].y + norms_[j].y * delta_));
+        path_out_.push_back(pt1);
+        pt1 = Point64(Round(path_in_[j].x - norms_[j].x * delta_), 
+          Round(path_in_[j].y - norms_[j].y * delta_));
+        path_out_.push_back(pt1);
       }
       else
       {
-        size_t k = 0;
-        for (size_t j = 1; j < path_in_size - 1; ++j)
-          OffsetPoint(j, k, node->join_type);
-
-        Point64 pt1;
-        if (node->end_type == kOpenButt)
-        {
-          size_t j = path_in_size - 1;
-          pt1 = Point64(Round(path_in_[j].x + norms_[j].x *
-            delta_), Round(path_in_[j].y + norms_[j].y * delta_));
-          path_out_.push_back(pt1);
-          pt1 = Point64(Round(path_in_[j].x - norms_[j].x * delta_), 
-            Round(path_in_[j].y - norms_[j].y * delta_));
-          path_out_.push_back(pt1);
-        }
-        else
-        {
-          size_t j = path_in_size - 1;
-          k = path_in_size - 2;
-          sin_a_ = 0;
-          norms_[j] = PointD(-norms_[j].x, -norms_[j].y);
-          if (node->end_type == kOpenSquare) DoSquare(j, k);
-          else DoRound(j, k);
-        }
+        size_t j = path_in_size - 1;
+        k = path_in_size - 2;
+        sin_a_ = 0;
+        norms_[j] = PointD(-norms_[j].x, -norms_[j].y);
+        if (node.end_type == kOpenSquare) DoSquare(j, k);
+        else DoRound(j, k);
+      }
 
-        //reverse norms_ ...
-        for (size_t j = path_in_size - 1; j > 0; j--)
-          norms_[j] = PointD(-norms_[j - 1].x, -norms_[j - 1].y);
-        norms_[0] = PointD(-norms_[1].x, -norms_[1].y);
+      //reverse norms_ ...
+      for (size_t j = path_in_size - 1; j > 0; j--)
+        norms_[j] = PointD(-norms_[j - 1].x, -norms_[j - 1].y);
+      norms_[0] = PointD(-norms_[1].x, -norms_[1].y);
 
-        k = path_in_size - 1;
-        for (size_t j = k - 1; j > 0; --j) OffsetPoint(j, k, node->join_type);
+      k = path_in_size - 1;
+      for (size_t j = k - 1; j > 0; --j) OffsetPoint(j, k, node.join_type);
+      SetVertexDelta(0);
 
-        if (node->end_type == kOpenButt)
-        {
-          pt1 = Point64(Round(path_in_[0].x - norms_[0].x * delta_),
-            Round(path_in_[0].y - norms_[0].y * delta_));
-          path_out_.push_back(pt1);
-          pt1 = Point64(Round(path_in_[0].x + norms_[0].x * delta_),
-            Round(path_in_[0].y + norms_[0].y * delta_));
-          path_out_.push_back(pt1);
-        }
-        else
-        {
-          k = 1;
-          sin_a_ = 0;
-          if (node->end_type == kOpenSquare) DoSquare(0, 1);
-          else DoRound(0, 1);
-        }
-        solution_.push_back(path_out_);
+      if (node.end_type == kOpenButt)
+      {
+        pt1 = Point64(Round(path_in_[0].x - norms_[0].x * delta_),
+          Round(path_in_[0].y - norms_[0].y * delta_));
+        path_out_.push_back(pt1);
+        pt1 = Point64(Round(path_in_[0].x + norms_[0].x * delta_),
+          Round(path_in_[0].y + norms_[0].y * delta_));
+        path_out_.push_back(pt1);
       }
+      else
+      {
+        k = 1;
+        sin_a_ = 0;
+        if (node.end_type == kOpenSquare) DoSquare(0, 1);
+        else DoRound(0, 1);
+      }
+      solution_.push_back(path_out_);
     }
-    norms_.clear();
-    path_in_.clear();
-    path_out_.clear();
+  }
+  //---------------------------------------------------------------------------
+
+  ClipperOffset::PathNode* ClipperOffset::NewNode(const Path &p, JoinType jt, 
+    EndType et, const std::vector< double > *vertex_deltas)
+  {
+    void *mem = mr_->Allocate(sizeof(PathNode));
+    try {
+      return new (mem) PathNode(p, jt, et, vertex_deltas);
+    }
+    catch (...) {
+      mr_->Deallocate(mem, sizeof(PathNode));
+      throw;
+    }
+  }
+  //---------------------------------------------------------------------------
+
+  void ClipperOffset::AddNode(PathNode *pn, unsigned group)
+  {
+    //empty nodes (eg paths of duplicate points) are discarded ...
+    pn->group = group;
+    if (!pn->path.empty()) {
+      nodes_.push_back(pn);
+      return;
+    }
+    pn->~PathNode();
+    mr_->Deallocate(pn, sizeof(PathNode));
   }
   //---------------------------------------------------------------------------
 
   void ClipperOffset::Clear()
   {
-    for (NodeList::iterator nl_iter = nodes_.begin(); nl_iter != nodes_.end(); ++nl_iter)
-      delete (*nl_iter);
+    for (NodeList::iterator nl_iter = nodes_.begin(); nl_iter != nodes_.end(); ++nl_iter) {
+      (*nl_iter)->~PathNode();
+      mr_->Deallocate(*nl_iter, sizeof(PathNode));
+    }
     nodes_.clear();
     norms_.clear();
     solution_.clear();
   }
   //---------------------------------------------------------------------------
 
-  void ClipperOffset::AddPath(const Path &path, JoinType jt, EndType et)
+  void ClipperOffset::AddPath(const Path &path, JoinType jt, EndType et, unsigned group)
+  {
+    AddNode(NewNode(path, jt, et), group);
+  }
+  //---------------------------------------------------------------------------
+
+  void ClipperOffset::AddPath(const Path &path, double delta, JoinType jt, 
+    EndType et, unsigned group)
+  {
+    PathNode *pn = NewNode(path, jt, et);
+    pn->deltas.push_back(delta);
+    AddNode(pn, group);
+  }
+  //---------------------------------------------------------------------------
+
+  void ClipperOffset::AddPath(const Path &path, const std::vector< double > &deltas, 
+    JoinType jt, EndType et, unsigned group)
   {
-    PathNode *pn = new PathNode(path, jt, et);
-    if (pn->path.empty()) delete pn;
-    else nodes_.push_back(pn);
+    if (deltas.size() != path.size())
+      throw ClipperException("AddPath: there must be one delta per vertex.");
+    AddNode(NewNode(path, jt, et, &deltas), group);
   }
   //---------------------------------------------------------------------------
 
-  void ClipperOffset::AddPaths(const Paths &paths, JoinType jt, EndType et)
+  void ClipperOffset::AddPaths(const Paths &paths, JoinType jt, EndType et, unsigned group)
   {
     for (Paths::const_iterator p_iter = paths.begin(); p_iter != paths.end(); ++p_iter)
-      AddPath(*p_iter, jt, et);
+      AddPath(*p_iter, jt, et, group);
+  }
+  //---------------------------------------------------------------------------
+
+  void ClipperOffset::AddPaths(const Paths &paths, double delta, JoinType jt, 
+    EndType et, unsigned group)
+  {
+    for (Paths::const_iterator p_iter = paths.begin(); p_iter != paths.end(); ++p_iter)
+      AddPath(*p_iter, delta, jt, et, group);
+  }
+  //---------------------------------------------------------------------------
+
+  void ClipperOffset::AddPolyPath(PolyPath &pp, JoinType jt, unsigned group, 
+    bool reverse)
+  {
+    for (int i = 0; i < pp.ChildCount(); ++i)
+    {
+      PolyPath &child = pp.GetChild(i);
+      PathNode *pn;
+      if (reverse) {
+        Path p(child.GetPath().rbegin(), child.GetPath().rend());
+        pn = NewNode(p, jt, kPolygon);
+      }
+      else
+        pn = NewNode(child.GetPath(), jt, kPolygon);
+      pn->oriented = true;
+      AddNode(pn, group);
+      AddPolyPath(child, jt, group, reverse);
+    }
+  }
+  //---------------------------------------------------------------------------
+
+  void ClipperOffset::AddPolyTree(PolyTree &tree, JoinType jt, unsigned group)
+  {
+    //outers and holes have opposite orientations, so the tree's orientation
+    //is known from any one outer (and outers are made positive here) ...
+    bool reverse = false;
+    for (int i = 0; i < tree.ChildCount(); ++i)
+    {
+      double a = Area(tree.GetChild(i).GetPath());
+      if (a == 0) continue;
+      reverse = (a < 0);
+      break;
+    }
+    AddPolyPath(tree, jt, group, reverse);
   }
   //---------------------------------------------------------------------------
 
@@ -442,18 +606,150 @@ namespace clipperlib {
     GetLowestPolygonIdx();
     bool negate = (lowest_idx_ >= 0 && Area(nodes_[lowest_idx_]->path) < 0);
     //if polygon orientations are reversed, then 'negate' ...
-    if (negate) delta_ = -delta;
-    else delta_ = delta;
-    DoOffset(delta_);
+    DoOffset(negate ? -delta : delta, negate);
 
     //now clean up 'corners' ...
-    Clipper clpr;
+    Clipper clpr(mr_);
     clpr.AddPaths(solution_, ptSubject);
     if (negate) clpr.Execute(ctUnion, sol, frNegative);
     else clpr.Execute(ctUnion, sol, frPositive);
   }
   //---------------------------------------------------------------------------
 
+  void ClipperOffset::Execute(PolyTree &sol, double delta)
+  {
+    sol.Clear();
+    solution_.clear();
+    if (nodes_.size() == 0) return;
+
+    GetLowestPolygonIdx();
+    bool negate = (lowest_idx_ >= 0 && Area(nodes_[lowest_idx_]->path) < 0);
+    DoOffset(negate ? -delta : delta, negate);
+
+    Clipper clpr(mr_);
+    Paths open_paths;
+    clpr.AddPaths(solution_, ptSubject);
+    if (negate) clpr.Execute(ctUnion, sol, open_paths, frNegative);
+    else clpr.Execute(ctUnion, sol, open_paths, frPositive);
+  }
+  //---------------------------------------------------------------------------
+
+  void ClipperOffset::OffsetWorker(WorkerJob *worker_job)
+  {
+    //each worker has its own buffers (path_in_, norms_ etc) ...
+    OffsetJob *job = static_cast<OffsetJob*>(worker_job);
+    const ClipperOffset &owner = *job->owner;
+    ClipperOffset co(owner.miter_limit_, owner.arc_tolerance_, owner.mr_);
+    co.delta_sign_ = job->negate ? -1 : 1;
+    co.base_delta_ = job->delta;
+    co.SetOffsetParams(job->delta);
+    for (;;) {
+      size_t chunk = job->next++;
+      if (chunk >= job->chunks.size() || job->failed) break;
+      size_t end = std::min((chunk + 1) * OFFSET_CHUNK_SIZE, owner.nodes_.size());
+      for (size_t i = chunk * OFFSET_CHUNK_SIZE; i < end; ++i)
+        co.OffsetNode(*owner.nodes_[i]);
+      co.solution_.swap(job->chunks[chunk]);
+      co.solution_.clear();
+    }
+  }
+  //---------------------------------------------------------------------------
+
+  void ClipperOffset::GroupWorker(WorkerJob *worker_job)
+  {
+    //the worker's ClipperOffset borrows each group's nodes in turn (so it
+    //mustn't Clear them), which keeps each group's offset and union 
+    //identical to that of a ClipperOffset containing only that group ...
+    GroupJob *job = static_cast<GroupJob*>(worker_job);
+    const ClipperOffset &owner = *job->owner;
+    ClipperOffset co(owner.miter_limit_, owner.arc_tolerance_, owner.mr_);
+    try {
+      for (;;) {
+        size_t i = job->next++;
+        if (i >= job->groups.size() || job->failed) break;
+        co.nodes_ = job->groups[i];
+        co.Execute((*job->sols)[i], job->delta);
+        co.nodes_.clear();
+      }
+    }
+    catch (...) {
+      co.nodes_.clear();
+      throw;
+    }
+  }
+  //---------------------------------------------------------------------------
+
+  void ClipperOffset::Execute(PathsList &sols, std::vector< unsigned > &group_ids,
+    double delta, unsigned thread_cnt)
+  {
+    sols.clear();
+    group_ids.clear();
+    if (nodes_.size() == 0) return;
+
+    GroupJob job;
+    job.owner = this;
+    job.delta = delta;
+    job.sols = &sols;
+    //each distinct id gets a slot, in id order ...
+    group_ids.reserve(nodes_.size());
+    for (NodeList::iterator nl_iter = nodes_.begin(); nl_iter != nodes_.end(); ++nl_iter)
+      group_ids.push_back((*nl_iter)->group);
+    std::sort(group_ids.begin(), group_ids.end());
+    group_ids.erase(std::unique(group_ids.begin(), group_ids.end()), group_ids.end());
+    job.groups.resize(group_ids.size());
+    for (NodeList::iterator nl_iter = nodes_.begin(); nl_iter != nodes_.end(); ++nl_iter) {
+      size_t slot = std::lower_bound(group_ids.begin(), group_ids.end(), 
+        (*nl_iter)->group) - group_ids.begin();
+      job.groups[slot].push_back(*nl_iter);
+    }
+    sols.resize(group_ids.size());
+    try {
+      RunWorkers(job, GroupWorker, thread_cnt, job.groups.size());
+    }
+    catch (...) {
+      sols.clear();
+      group_ids.clear();
+      throw;
+    }
+  }
+  //---------------------------------------------------------------------------
+
+  void ClipperOffset::ExecuteTriangles(Paths &triangles, double delta, 
+    const Rect64 &clip_rect, unsigned thread_cnt)
+  {
+    triangles.clear();
+    solution_.clear();
+    if (nodes_.size() == 0 || clip_rect.right <= clip_rect.left ||
+      clip_rect.bottom <= clip_rect.top) return;
+
+    GetLowestPolygonIdx();
+    bool negate = (lowest_idx_ >= 0 && Area(nodes_[lowest_idx_]->path) < 0);
+    if (negate) delta = -delta;
+
+    //the raw offset paths go straight into the triangulating sweep, where the
+    //fill rule removes the 'corners' just as Execute's union does ...
+    ClipperTri clpr(mr_);
+    OffsetJob job;
+    job.owner = this;
+    job.delta = delta;
+    job.negate = negate;
+    job.chunks.resize((nodes_.size() + OFFSET_CHUNK_SIZE - 1) / OFFSET_CHUNK_SIZE);
+    RunWorkers(job, OffsetWorker, thread_cnt, job.chunks.size());
+    for (size_t i = 0; i < job.chunks.size(); ++i)
+      clpr.AddPaths(job.chunks[i], ptSubject);
+
+    //and clip_rect is oriented to suit the same fill rule ...
+    Path clip(4);
+    clip[0] = Point64(clip_rect.left, clip_rect.top);
+    clip[1] = Point64(clip_rect.right, clip_rect.top);
+    clip[2] = Point64(clip_rect.right, clip_rect.bottom);
+    clip[3] = Point64(clip_rect.left, clip_rect.bottom);
+    if (negate) std::reverse(clip.begin(), clip.end());
+    clpr.AddPath(clip, ptClip);
+    clpr.Execute(ctIntersection, triangles, negate ? frNegative : frPositive);
+  }
+  //---------------------------------------------------------------------------
+
   void OffsetPaths(Paths &paths_in, Paths &paths_out, double delta, JoinType jt, EndType et)
   {
     ClipperOffset co;
@@ -40,9 +40,16 @@ namespace clipperlib {
       JoinType join_type;
       EndType end_type;
       int lowest_idx;
-      PathNode(const Path &p, JoinType jt, EndType et);
+      unsigned group;
+      bool oriented; //outers are known to be positive (see AddPolyTree)
+      std::vector< double > deltas; //empty, one per path or one per vertex
+      PathNode(const Path &p, JoinType jt, EndType et,
+        const std::vector< double > *vertex_deltas = NULL);
     };
 
+    struct OffsetJob;
+    struct GroupJob;
+
     typedef std::vector< PointD > NormalsList;
     typedef std::vector< PathNode* > NodeList;
 
@@ -52,25 +59,79 @@ namespace clipperlib {
     NodeList nodes_;
     double arc_tolerance_;
     double miter_limit_;
+    MemoryResource *mr_;
 
     //nb: miter_lim_ below is a temp field that differs from miter_limit
-    double delta_, sin_a_, sin_, cos_, miter_lim_, steps_per_radian_;
+    double delta_, sin_a_, sin_, cos_, miter_lim_, steps_, steps_per_radian_;
+    //base_delta_: the delta for paths without their own (already negated when
+    //orientations are reversed), and delta_sign_ negates the paths' own deltas
+    double base_delta_, delta_sign_;
+    const std::vector< double > *vertex_deltas_;
     int lowest_idx_;
+    PathNode* NewNode(const Path &p, JoinType jt, EndType et,
+      const std::vector< double > *vertex_deltas = NULL);
+    void AddNode(PathNode *pn, unsigned group);
     void GetLowestPolygonIdx();
     void OffsetPoint(size_t j, size_t &k, JoinType join_type);
     void DoSquare(int j, int k);
     void DoMiter(int j, int k, double cos_a_plus_1);
     void DoRound(int j, int k);
-    void DoOffset(double d);
+    void SetOffsetParams(double d);
+    void UseDelta(double d) { if (d != delta_) SetOffsetParams(d); }
+    void SetVertexDelta(size_t j);
+    void OffsetNode(const PathNode &node);
+    void DoOffset(double d, bool negate);
+    void AddPolyPath(PolyPath &pp, JoinType jt, unsigned group, bool reverse);
+    static void OffsetWorker(WorkerJob *worker_job);
+    static void GroupWorker(WorkerJob *worker_job);
     static PointD GetUnitNormal(const Point64 &pt1, const Point64 &pt2);
+    ClipperOffset(const ClipperOffset&);             //not copyable
+    ClipperOffset& operator=(const ClipperOffset&);
 
   public:
-    ClipperOffset(double miter_limit = 2.0, double arc_tolerance = 0) :
-      arc_tolerance_(arc_tolerance), miter_limit_(miter_limit) {}
+    //mr: for the offsetter's paths and its Clipper engines (NULL: the global
+    //heap). It's shared by the worker threads of the threaded Executes.
+    ClipperOffset(double miter_limit = 2.0, double arc_tolerance = 0, 
+      MemoryResource *mr = NULL) :
+      arc_tolerance_(arc_tolerance), miter_limit_(miter_limit), 
+      mr_(mr ? mr : DefaultMemoryResource()), delta_(0),
+      base_delta_(0), delta_sign_(1), vertex_deltas_(NULL) {}
+    ~ClipperOffset() { Clear(); }
     void Clear();
-    void AddPath(const Path &path, JoinType jt, EndType et);
-    void AddPaths(const Paths &paths, JoinType jt, EndType et);
+    //group: see the grouped Execute below (otherwise groups are ignored)
+    void AddPath(const Path &path, JoinType jt, EndType et, unsigned group = 0);
+    void AddPaths(const Paths &paths, JoinType jt, EndType et, unsigned group = 0);
+    //these paths are offset by their own delta instead of Execute's delta ...
+    void AddPath(const Path &path, double delta, JoinType jt, EndType et, 
+      unsigned group = 0);
+    void AddPaths(const Paths &paths, double delta, JoinType jt, EndType et, 
+      unsigned group = 0);
+    //and here each vertex has its own delta (so deltas.size() == path.size()),
+    //which tapers the offset between vertices. Deltas should share one sign.
+    void AddPath(const Path &path, const std::vector< double > &deltas, 
+      JoinType jt, EndType et, unsigned group = 0);
+    //AddPolyTree: adds the tree's polygons, whose outer and hole orientations
+    //are then already known (so they aren't probed again in Execute). Any
+    //other polygons should be oriented like Clipper's solutions (outers with
+    //positive areas).
+    void AddPolyTree(PolyTree &tree, JoinType jt, unsigned group = 0);
     void Execute(Paths &sol, double delta);
+    //Execute (PolyTree): nesting comes directly from the union that cleans up
+    //the offset, so the solution doesn't need a further Clipper pass.
+    void Execute(PolyTree &sol, double delta);
+    //Execute (grouped): each group of paths is offset and unioned separately,
+    //with sols[i] holding the solution for group group_ids[i] (and group_ids
+    //in ascending order). Any ids may be used (eg hashes) since only those
+    //used get a solution. Groups are shared among thread_cnt threads (0: one
+    //per hardware thread).
+    void Execute(PathsList &sols, std::vector< unsigned > &group_ids, 
+      double delta, unsigned thread_cnt = 0);
+    //ExecuteTriangles: offsets the paths, then clips them to clip_rect and
+    //triangulates the result in a single ClipperTri sweep (instead of the union
+    //in Execute, a separate clip and then triangulation). Paths are offset on
+    //thread_cnt threads (0: one per hardware thread).
+    void ExecuteTriangles(Paths &triangles, double delta, const Rect64 &clip_rect,
+      unsigned thread_cnt = 0);
   };
 
 } //clipperlib namespace
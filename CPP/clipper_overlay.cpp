@@ -0,0 +1,162 @@
+/*******************************************************************************
+* Author    :  Angus Johnson                                                   *
+* Version   :  10.0 (beta)                                                     *
+* Date      :  8 November 2017                                                 *
+* Website   :  http://www.angusj.com                                           *
+* Copyright :  Angus Johnson 2010-2017                                         *
+* Purpose   :  Overlay join - intersects every subject with every clip whose   *
+*              bounds overlap, and returns the results per (subject, clip)     *
+* License   :  http://www.boost.org/LICENSE_1_0.txt                            *
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <vector>
+#include <algorithm>
+#include "clipper_overlay.h"
+#include "clipper_predicates.h"
+#include "clipper.h"
+
+namespace clipperlib {
+
+  //each worker thread takes this many candidate pairs at a time ...
+  #define OVERLAY_CHUNK_SIZE (64)
+
+  struct BoundsItem {
+    Rect64 bounds;
+    size_t id;
+    bool is_clip;
+    BoundsItem(const Rect64 &r, size_t i, bool clip): bounds(r), id(i), is_clip(clip) {}
+  };
+
+  typedef std::vector< BoundsItem > BoundsItems;
+  typedef std::vector< const BoundsItem* > BoundsItemPtrs;
+
+  struct OverlayJob : public WorkerJob {
+    const PathsList *subjects;
+    const PathsList *clips;
+    FillRule fill_rule;
+    OverlayResults *candidates;
+  };
+
+  //------------------------------------------------------------------------------
+  // Miscellaneous functions ...
+  //------------------------------------------------------------------------------
+
+  inline bool BoundsItemLess(const BoundsItem &a, const BoundsItem &b)
+  {
+    return a.bounds.left < b.bounds.left;
+  }
+  //------------------------------------------------------------------------------
+
+  inline bool CandidateLess(const OverlayResult &a, const OverlayResult &b)
+  {
+    if (a.subject_id != b.subject_id) return a.subject_id < b.subject_id;
+    return a.clip_id < b.clip_id;
+  }
+  //------------------------------------------------------------------------------
+
+  static void AddCandidates(const BoundsItem &item, BoundsItemPtrs &others, 
+    OverlayResults &candidates)
+  {
+    //'others' holds the other set's items that began left of item, so discard
+    //those that also end left of it and pair item with the rest that overlap ...
+    size_t j = 0;
+    for (size_t i = 0; i < others.size(); ++i) {
+      const BoundsItem *other = others[i];
+      if (other->bounds.right <= item.bounds.left) continue;
+      others[j++] = other;
+      if (other->bounds.top >= item.bounds.bottom ||
+        item.bounds.top >= other->bounds.bottom) continue;
+      OverlayResult cand;
+      cand.subject_id = item.is_clip ? other->id : item.id;
+      cand.clip_id = item.is_clip ? item.id : other->id;
+      candidates.push_back(cand);
+    }
+    others.resize(j);
+  }
+  //------------------------------------------------------------------------------
+
+  static void GetCandidates(const PathsList &subjects, const PathsList &clips,
+    OverlayResults &candidates)
+  {
+    //a sort and sweep (along the x axis) of both sets' bounding rectangles
+    BoundsItems items;
+    items.reserve(subjects.size() + clips.size());
+    for (size_t i = 0; i < subjects.size(); ++i)
+      items.push_back(BoundsItem(GetPathsBounds(subjects[i]), i, false));
+    for (size_t i = 0; i < clips.size(); ++i)
+      items.push_back(BoundsItem(GetPathsBounds(clips[i]), i, true));
+    std::stable_sort(items.begin(), items.end(), BoundsItemLess);
+
+    BoundsItemPtrs active_subjects, active_clips;
+    for (BoundsItems::const_iterator it = items.begin(); it != items.end(); ++it) {
+      if (it->bounds.left >= it->bounds.right || 
+        it->bounds.top >= it->bounds.bottom) continue; //no area
+      if (it->is_clip) {
+        AddCandidates(*it, active_subjects, candidates);
+        active_clips.push_back(&*it);
+      } else {
+        AddCandidates(*it, active_clips, candidates);
+        active_subjects.push_back(&*it);
+      }
+    }
+    std::sort(candidates.begin(), candidates.end(), CandidateLess);
+  }
+  //------------------------------------------------------------------------------
+
+  static void OverlayWorker(WorkerJob *worker_job)
+  {
+    OverlayJob *job = static_cast<OverlayJob*>(worker_job);
+    Clipper clipper;
+    OverlayResults &candidates = *job->candidates;
+    for (;;) {
+      size_t start = job->next.fetch_add(OVERLAY_CHUNK_SIZE);
+      if (start >= candidates.size() || job->failed) break;
+      size_t end = std::min(start + OVERLAY_CHUNK_SIZE, candidates.size());
+      for (size_t i = start; i < end; ++i) {
+        OverlayResult &cand = candidates[i];
+        clipper.Clear();
+        clipper.AddPaths((*job->subjects)[cand.subject_id], ptSubject);
+        clipper.AddPaths((*job->clips)[cand.clip_id], ptClip);
+        clipper.Execute(ctIntersection, cand.solution, job->fill_rule);
+      }
+    }
+  }
+  //------------------------------------------------------------------------------
+
+  void OverlayJoin(const PathsList &subjects, const PathsList &clips,
+    OverlayResults &results, FillRule fr, unsigned thread_cnt)
+  {
+    results.clear();
+    GetCandidates(subjects, clips, results);
+
+    OverlayJob job;
+    job.subjects = &subjects;
+    job.clips = &clips;
+    job.fill_rule = fr;
+    job.candidates = &results;
+    size_t chunk_cnt = (results.size() + OVERLAY_CHUNK_SIZE - 1) / OVERLAY_CHUNK_SIZE;
+    try {
+      RunWorkers(job, OverlayWorker, thread_cnt, chunk_cnt);
+    }
+    catch (...) {
+      results.clear();
+      throw;
+    }
+
+    //finally, remove the candidates whose bounds overlapped but not their fill
+    size_t j = 0;
+    for (size_t i = 0; i < results.size(); ++i) {
+      if (results[i].solution.empty()) continue;
+      if (i != j) {
+        results[j].subject_id = results[i].subject_id;
+        results[j].clip_id = results[i].clip_id;
+        results[j].solution.swap(results[i].solution);
+      }
+      ++j;
+    }
+    results.resize(j);
+  }
+  //------------------------------------------------------------------------------
+
+} //namespace
@@ -0,0 +1,38 @@
+/*******************************************************************************
+* Author    :  Angus Johnson                                                   *
+* Version   :  10.0 (beta)                                                     *
+* Date      :  8 November 2017                                                 *
+* Website   :  http://www.angusj.com                                           *
+* Copyright :  Angus Johnson 2010-2017                                         *
+* Purpose   :  Overlay join - intersects every subject with every clip whose   *
+*              bounds overlap, and returns the results per (subject, clip)     *
+* License   :  http://www.boost.org/LICENSE_1_0.txt                            *
+*******************************************************************************/
+
+#ifndef clipper_overlay_h
+#define clipper_overlay_h
+
+#include <vector>
+#include <cstdlib>
+#include "clipper.h"
+
+namespace clipperlib {
+
+  struct OverlayResult {
+    size_t subject_id; //index into subjects
+    size_t clip_id;    //index into clips
+    Paths solution;    //the intersection of subjects[subject_id] & clips[clip_id]
+  };
+
+  typedef std::vector< OverlayResult > OverlayResults;
+
+  //OverlayJoin: intersects each subject with each clip whose bounds overlap
+  //its own. Only non-empty intersections are returned, ordered by subject_id
+  //then by clip_id. The pairs are shared among thread_cnt threads (0: one per 
+  //hardware thread) and each thread reuses a single Clipper object.
+  void OverlayJoin(const PathsList &subjects, const PathsList &clips,
+    OverlayResults &results, FillRule fr = frNonZero, unsigned thread_cnt = 0);
+
+} //namespace
+
+#endif //clipper_overlay_h
@@ -0,0 +1,593 @@
+/*******************************************************************************
+* Author    :  Angus Johnson                                                   *
+* Version   :  10.0 (beta)                                                     *
+* Date      :  8 November 2017                                                 *
+* Website   :  http://www.angusj.com                                           *
+* Copyright :  Angus Johnson 2010-2017                                         *
+* Purpose   :  Yes/no spatial predicates that stop the sweep as soon as known  *
+* License   :  http://www.boost.org/LICENSE_1_0.txt                            *
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include "clipper_predicates.h"
+#include "clipper.h"
+
+namespace clipperlib {
+
+  enum PointInResult { pirOutside, pirInside, pirOnEdge };
+
+  //------------------------------------------------------------------------------
+  // Miscellaneous functions ...
+  //------------------------------------------------------------------------------
+
+  Rect64 GetPathsBounds(const Paths &paths)
+  {
+    const int64_t hi = std::numeric_limits<int64_t>::max();
+    const int64_t lo = std::numeric_limits<int64_t>::min();
+    Rect64 result = Rect64(hi, hi, lo, lo);
+    for (Paths::const_iterator p = paths.begin(); p != paths.end(); ++p)
+      for (Path::const_iterator pt = p->begin(); pt != p->end(); ++pt) {
+        if (pt->x < result.left) result.left = pt->x;
+        if (pt->x > result.right) result.right = pt->x;
+        if (pt->y < result.top) result.top = pt->y;
+        if (pt->y > result.bottom) result.bottom = pt->y;
+      }
+    return result;
+  }
+  //------------------------------------------------------------------------------
+
+  inline bool IsEmptyRect(const Rect64 &r) 
+  { 
+    return r.left >= r.right || r.top >= r.bottom; 
+  }
+  //------------------------------------------------------------------------------
+
+  inline bool RectsOverlap(const Rect64 &r1, const Rect64 &r2)
+  {
+    return r1.left < r2.right && r2.left < r1.right &&
+      r1.top < r2.bottom && r2.top < r1.bottom;
+  }
+  //------------------------------------------------------------------------------
+
+  inline bool RectContains(const Rect64 &outer, const Rect64 &inner)
+  {
+    return inner.left >= outer.left && inner.right <= outer.right &&
+      inner.top >= outer.top && inner.bottom <= outer.bottom;
+  }
+  //------------------------------------------------------------------------------
+
+  PointInResult PointInPaths(const Point64 &pt, const Paths &paths, FillRule fr)
+  {
+    //winding number test (see also Hormann & Agathos, 2001)
+    int wind_cnt = 0;
+    for (Paths::const_iterator p = paths.begin(); p != paths.end(); ++p) {
+      size_t cnt = p->size();
+      if (cnt < 3) continue;
+      Point64 prev = (*p)[cnt - 1];
+      for (size_t i = 0; i < cnt; ++i) {
+        const Point64 &curr = (*p)[i];
+        if (curr.y == pt.y && (curr.x == pt.x || 
+          (prev.y == pt.y && ((curr.x > pt.x) != (prev.x > pt.x)))))
+            return pirOnEdge;
+        if ((prev.y < pt.y) != (curr.y < pt.y)) {
+          double cp = double(prev.x - pt.x) * double(curr.y - pt.y) -
+            double(curr.x - pt.x) * double(prev.y - pt.y);
+          if (cp == 0) return pirOnEdge;
+          if ((cp > 0) == (curr.y > prev.y)) 
+            wind_cnt += (curr.y > prev.y) ? 1 : -1;
+        }
+        prev = curr;
+      }
+    }
+    bool result;
+    switch (fr) {
+      case frEvenOdd: result = (wind_cnt & 1) != 0; break;
+      case frNonZero: result = wind_cnt != 0; break;
+      case frPositive: result = wind_cnt > 0; break;
+      default: result = wind_cnt < 0; break;
+    }
+    return result ? pirInside : pirOutside;
+  }
+  //------------------------------------------------------------------------------
+
+  inline bool IsCollinear(const Point64 &p1, const Point64 &p2, const Point64 &p3)
+  {
+    return double(p2.x - p1.x) * double(p3.y - p2.y) ==
+      double(p3.x - p2.x) * double(p2.y - p1.y);
+  }
+  //------------------------------------------------------------------------------
+
+  bool HasArea(const OutPt *op)
+  {
+    //nb: as soon as a solution path has 3 consecutive vertices that aren't
+    //collinear, the solution can't be empty. (Paths with only collinear 
+    //vertices, eg where regions just touch, may yet come to nothing.)
+    const OutPt *op2 = op;
+    do {
+      if (!IsCollinear(op2->prev->pt, op2->pt, op2->next->pt)) return true;
+      op2 = op2->next;
+    } while (op2 != op);
+    return false;
+  }
+  //------------------------------------------------------------------------------
+
+  //------------------------------------------------------------------------------
+  // ClipperPredicate methods ...
+  //------------------------------------------------------------------------------
+
+  OutPt* ClipperPredicate::AddOutPt(Active &e, const Point64 pt)
+  {
+    OutPt *result = Clipper::AddOutPt(e, pt);
+    if (e.is_open || found_ || result->prev == result->next) return result;
+    if (IsCollinear(result->prev->pt, pt, result->next->pt)) return result;
+    found_ = true;
+    StopExecute();
+    return result;
+  }
+  //------------------------------------------------------------------------------
+
+  void ClipperPredicate::AddLocalMaxPoly(Active &e1, Active &e2, const Point64 pt)
+  {
+    OutRec *or1 = e1.outrec, *or2 = e2.outrec;
+    Clipper::AddLocalMaxPoly(e1, e2, pt);
+    if (e1.is_open || found_) return;
+    //joining paths adds vertex neighbours, so check the joined path again ...
+    OutRec *outrec = or1->pts ? or1 : or2;
+    if (!outrec->pts || !HasArea(outrec->pts)) return;
+    found_ = true;
+    StopExecute();
+  }
+  //------------------------------------------------------------------------------
+
+  bool ClipperPredicate::Execute(ClipType clipType, bool &is_empty, FillRule fr)
+  {
+    found_ = false;
+    bool result = ExecuteInternal(clipType, fr);
+    is_empty = !found_;
+    CleanUp();
+    return result;
+  }
+  //------------------------------------------------------------------------------
+
+  inline int64_t Round(double val)
+  {
+    if ((val < 0)) return static_cast<int64_t>(val - 0.5);
+    else return static_cast<int64_t>(val + 0.5);
+  }
+  //------------------------------------------------------------------------------
+
+  inline uint64_t AbsU64(int64_t val)
+  {
+    return val < 0 ? 0 - static_cast<uint64_t>(val) : static_cast<uint64_t>(val);
+  }
+  //------------------------------------------------------------------------------
+
+  inline void MulU64(uint64_t a, uint64_t b, uint64_t &hi, uint64_t &lo)
+  {
+    //the 128 bit product of a and b, from its 32 bit halves
+    uint64_t a_lo = a & 0xFFFFFFFF, a_hi = a >> 32;
+    uint64_t b_lo = b & 0xFFFFFFFF, b_hi = b >> 32;
+    uint64_t p0 = a_lo * b_lo, p1 = a_lo * b_hi, p2 = a_hi * b_lo;
+    uint64_t mid = (p0 >> 32) + (p1 & 0xFFFFFFFF) + (p2 & 0xFFFFFFFF);
+    lo = (p0 & 0xFFFFFFFF) | (mid << 32);
+    hi = a_hi * b_hi + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+  }
+  //------------------------------------------------------------------------------
+
+  inline int Sign(int64_t val) { return (val > 0) - (val < 0); }
+  //------------------------------------------------------------------------------
+
+  int ProductsSign(int64_t a, int64_t b, int64_t c, int64_t d)
+  {
+    //the sign of (a * b - c * d), calculated exactly
+    int sign_ab = Sign(a) * Sign(b), sign_cd = Sign(c) * Sign(d);
+    if (sign_ab != sign_cd) return sign_ab > sign_cd ? 1 : -1;
+    if (!sign_ab) return 0;
+    uint64_t ab_hi, ab_lo, cd_hi, cd_lo;
+    MulU64(AbsU64(a), AbsU64(b), ab_hi, ab_lo);
+    MulU64(AbsU64(c), AbsU64(d), cd_hi, cd_lo);
+    if (ab_hi == cd_hi && ab_lo == cd_lo) return 0;
+    bool ab_larger = ab_hi > cd_hi || (ab_hi == cd_hi && ab_lo > cd_lo);
+    return ab_larger ? sign_ab : -sign_ab;
+  }
+  //------------------------------------------------------------------------------
+
+  inline int Orientation(const Point64 &p1, const Point64 &p2, const Point64 &p3)
+  {
+    //1: p3 is to one side of the line through p1 and p2, -1: the other side,
+    //0: it's on the line
+    return ProductsSign(p2.x - p1.x, p3.y - p1.y, p2.y - p1.y, p3.x - p1.x);
+  }
+  //------------------------------------------------------------------------------
+
+  inline bool InSegmentBounds(const Point64 &p1, const Point64 &p2, const Point64 &pt)
+  {
+    return ((p1.x <= pt.x && pt.x <= p2.x) || (p2.x <= pt.x && pt.x <= p1.x)) &&
+      ((p1.y <= pt.y && pt.y <= p2.y) || (p2.y <= pt.y && pt.y <= p1.y));
+  }
+  //------------------------------------------------------------------------------
+
+  bool SegmentsIntersect(const Point64 &a1, const Point64 &a2, 
+    const Point64 &b1, const Point64 &b2, Point64 &pt)
+  {
+    //true when the segments a1-a2 and b1-b2 cross or touch, with pt where they
+    //do (or where one of them touches the other when they're collinear)
+    int o1 = Orientation(a1, a2, b1), o2 = Orientation(a1, a2, b2);
+    if (o1 && o1 == o2) return false;
+    int o3 = Orientation(b1, b2, a1), o4 = Orientation(b1, b2, a2);
+    if (o3 && o3 == o4) return false;
+    if (o1 && o2 && o3 && o4) {
+      //a proper crossing, so only its location is approximate ...
+      double dax = double(a2.x - a1.x), day = double(a2.y - a1.y);
+      double dbx = double(b2.x - b1.x), dby = double(b2.y - b1.y);
+      double t = (double(b1.x - a1.x) * dby - double(b1.y - a1.y) * dbx) /
+        (dax * dby - day * dbx);
+      pt = Point64(a1.x + Round(t * dax), a1.y + Round(t * day));
+      return true;
+    }
+    if (!o1 && InSegmentBounds(a1, a2, b1)) pt = b1;
+    else if (!o2 && InSegmentBounds(a1, a2, b2)) pt = b2;
+    else if (!o3 && InSegmentBounds(b1, b2, a1)) pt = a1;
+    else if (!o4 && InSegmentBounds(b1, b2, a2)) pt = a2;
+    else return false; //collinear but apart
+    return true;
+  }
+  //------------------------------------------------------------------------------
+
+  inline bool PointLess(const Point64 &a, const Point64 &b)
+  {
+    return a.y < b.y || (a.y == b.y && a.x < b.x);
+  }
+  //------------------------------------------------------------------------------
+
+  inline bool ShareEndpoint(const Point64 &a1, const Point64 &a2,
+    const Point64 &b1, const Point64 &b2)
+  {
+    return a1 == b1 || a1 == b2 || a2 == b1 || a2 == b2;
+  }
+  //------------------------------------------------------------------------------
+
+  inline int64_t ScanX(const Active &e, const int64_t y)
+  {
+    //nb: the same rounding as the sweep (see TopX in clipper.cpp)
+    if (y == e.top.y) return e.top.x;
+    if (y == e.bot.y) return e.bot.x;
+    return e.bot.x + Round(e.dx * (y - e.bot.y));
+  }
+  //------------------------------------------------------------------------------
+
+  //------------------------------------------------------------------------------
+  // ClipperSelfIntersect methods ...
+  //------------------------------------------------------------------------------
+
+  void ClipperSelfIntersect::AddIntersection(const Point64 &pt)
+  {
+    found_ = true;
+    if (stop_at_first_) StopExecute();
+    else intersections_->push_back(pt);
+  }
+  //------------------------------------------------------------------------------
+
+  void ClipperSelfIntersect::AddPath(const Path &path, PathType polytype, bool is_open)
+  {
+    int path_id = path_cnt();
+    Clipper::AddPath(path, polytype, is_open);
+    //copy the path's vertices as Clipper sees them (ie without duplicates) ...
+    size_t cnt = path.size();
+    while (cnt > 1 && path[cnt - 1] == path[0]) --cnt;
+    path_pts_.clear();
+    for (size_t i = 0; i < cnt; ++i)
+      if (path_pts_.empty() || path[i] != path_pts_.back()) 
+        path_pts_.push_back(path[i]);
+    cnt = path_pts_.size();
+    if (cnt < 2) return;
+    size_t edge_cnt = is_open ? cnt - 1 : cnt;
+
+    //keep its horizontal edges (which are checked separately, see
+    //CheckHorizontals) ...
+    for (size_t i = 0; i < edge_cnt; ++i) {
+      const Point64 &pt = path_pts_[i], &next = path_pts_[(i + 1) % cnt];
+      if (pt.y != next.y) continue;
+      HorzEdge horz;
+      horz.y = pt.y;
+      horz.left = std::min(pt.x, next.x);
+      horz.right = std::max(pt.x, next.x);
+      horz.path_id = path_id;
+      horz_edges_.push_back(horz);
+    }
+
+    //find where path doubles back over itself ...
+    if (cnt == 2) {
+      if (!is_open) spikes_.push_back(path_pts_[1]);
+    }
+    else {
+      size_t first = is_open ? 1 : 0, last = is_open ? cnt - 2 : cnt - 1;
+      for (size_t i = first; i <= last; ++i) {
+        const Point64 &prev = path_pts_[(i + cnt - 1) % cnt], &curr = path_pts_[i],
+          &next = path_pts_[(i + 1) % cnt];
+        //ie collinear, and the dot product of the 2 edges' vectors is positive
+        if (!Orientation(prev, curr, next) && ProductsSign(prev.x - curr.x, 
+          next.x - curr.x, curr.y - prev.y, next.y - curr.y) > 0)
+            spikes_.push_back(curr);
+      }
+    }
+
+    //and vertices that it visits more than once. (Elsewhere, edges from the 
+    //same path that share an end are assumed to be adjacent.)
+    std::sort(path_pts_.begin(), path_pts_.end(), PointLess);
+    for (size_t i = 1; i < cnt; ++i)
+      if (path_pts_[i] == path_pts_[i - 1]) spikes_.push_back(path_pts_[i]);
+  }
+  //------------------------------------------------------------------------------
+
+  void ClipperSelfIntersect::IntersectEdges(Active &e1, Active &e2, const Point64 pt)
+  {
+    //nb: winding counts are only needed to build solutions so they're ignored,
+    //and intersections are checked in DoScanbeam (and CheckHorizontals)
+    e1.curr = pt;
+    e2.curr = pt;
+  }
+  //------------------------------------------------------------------------------
+
+  bool ClipperSelfIntersect::BotXLess(const ScanEdge &a, const ScanEdge &b)
+  {
+    return a.bot_x < b.bot_x;
+  }
+  //------------------------------------------------------------------------------
+
+  bool ClipperSelfIntersect::HorzLess(const HorzEdge &a, const HorzEdge &b)
+  {
+    //in the order the sweep reaches them (ie descending y), then left to right
+    return a.y > b.y || (a.y == b.y && a.left < b.left);
+  }
+  //------------------------------------------------------------------------------
+
+  bool ClipperSelfIntersect::EdgePairLess(const EdgePair &a, const EdgePair &b)
+  {
+    if (a.top1 != b.top1) return std::less< const Vertex* >()(a.top1, b.top1);
+    if (a.dir1 != b.dir1) return a.dir1 < b.dir1;
+    if (a.top2 != b.top2) return std::less< const Vertex* >()(a.top2, b.top2);
+    return a.dir2 < b.dir2;
+  }
+  //------------------------------------------------------------------------------
+
+  void ClipperSelfIntersect::CheckEdges(const Active &e1, const Active &e2)
+  {
+    //nb: adjacent edges share an end. (Edges from the same path that share an 
+    //end aren't otherwise adjacent when the path visits a vertex twice, but 
+    //that vertex has already been listed.)
+    if (e1.path_id == e2.path_id && 
+      ShareEndpoint(e1.bot, e1.top, e2.bot, e2.top)) return;
+    Point64 pt;
+    if (!SegmentsIntersect(e1.bot, e1.top, e2.bot, e2.top, pt)) return;
+
+    //edges can be checked in consecutive scanbeams, but they're only listed 
+    //the first time. (An edge is identified by its top vertex and direction.)
+    EdgePair ep;
+    ep.top1 = e1.vertex_top;
+    ep.dir1 = e1.wind_dx;
+    ep.top2 = e2.vertex_top;
+    ep.dir2 = e2.wind_dx;
+    if (std::less< const Vertex* >()(ep.top2, ep.top1) ||
+      (ep.top1 == ep.top2 && ep.dir2 < ep.dir1)) {
+        std::swap(ep.top1, ep.top2);
+        std::swap(ep.dir1, ep.dir2);
+    }
+    pairs_.push_back(ep);
+    if (!std::binary_search(prev_pairs_.begin(), prev_pairs_.end(), ep, EdgePairLess))
+      AddIntersection(pt);
+  }
+  //------------------------------------------------------------------------------
+
+  void ClipperSelfIntersect::CheckHorizontal(const HorzEdge &horz, const Active &e)
+  {
+    Point64 h1(horz.left, horz.y), h2(horz.right, horz.y), pt;
+    if (horz.path_id == e.path_id && ShareEndpoint(h1, h2, e.bot, e.top)) return;
+    if (SegmentsIntersect(h1, h2, e.bot, e.top, pt)) AddIntersection(pt);
+  }
+  //------------------------------------------------------------------------------
+
+  void ClipperSelfIntersect::CheckHorizontals()
+  {
+    //horizontals only meet other horizontals at the same y ...
+    std::sort(horz_edges_.begin(), horz_edges_.end(), HorzLess);
+    for (size_t i = 0; i < horz_edges_.size() && !(found_ && stop_at_first_); ++i) {
+      const HorzEdge &h1 = horz_edges_[i];
+      for (size_t j = i + 1; j < horz_edges_.size(); ++j) {
+        const HorzEdge &h2 = horz_edges_[j];
+        if (h2.y != h1.y || h2.left > h1.right) break;
+        if (h1.path_id == h2.path_id && (h2.left == h1.left || 
+          h2.left == h1.right || h2.right == h1.left || h2.right == h1.right))
+            continue; //adjacent
+        AddIntersection(Point64(h2.left, h1.y));
+      }
+    }
+  }
+  //------------------------------------------------------------------------------
+
+  void ClipperSelfIntersect::DoScanbeam(const int64_t bot_y, const int64_t top_y)
+  {
+    //Where each edge is at the bottom and the top of the scanbeam is rounded to
+    //the nearest integer, so edges whose rounded positions are more than one
+    //unit apart at both ends (and in the same order) can't meet within the 
+    //scanbeam. The remaining pairs are checked exactly.
+    bot_edges_.clear();
+    for (const Active *e = actives(); e; e = e->next_in_ael) {
+      if (e->top.y == e->bot.y) continue; //see CheckHorizontals
+      ScanEdge se;
+      se.bot_x = ScanX(*e, bot_y);
+      se.top_x = ScanX(*e, top_y);
+      se.edge = e;
+      //nb: the AEL is (very nearly) sorted on bot_x already ...
+      bot_edges_.push_back(se);
+      for (size_t i = bot_edges_.size() - 1; i > 0 && 
+        BotXLess(bot_edges_[i], bot_edges_[i - 1]); --i)
+          std::swap(bot_edges_[i], bot_edges_[i - 1]);
+    }
+
+    //sort a copy of the edges on top_x, by insertion (in bot_x order), when
+    //any edge that's inserted before (ie left of) another that's already 
+    //there, or that ends up within a unit of it, is checked against it ...
+    pairs_.clear();
+    top_edges_.clear();
+    for (size_t i = 0; i < bot_edges_.size(); ++i) {
+      const ScanEdge &se = bot_edges_[i];
+      top_edges_.push_back(se);
+      size_t j = top_edges_.size() - 1;
+      for ( ; j > 0 && top_edges_[j - 1].top_x > se.top_x; --j) {
+        top_edges_[j] = top_edges_[j - 1];
+        CheckEdges(*top_edges_[j].edge, *se.edge);
+      }
+      top_edges_[j] = se;
+      for (size_t k = j; k > 0 && top_edges_[k - 1].top_x >= se.top_x - 1; --k)
+        CheckEdges(*top_edges_[k - 1].edge, *se.edge);
+      //and those that are within a unit at the bottom but not at the top ...
+      for (size_t k = i; k > 0 && bot_edges_[k - 1].bot_x >= se.bot_x - 1; --k)
+        if (bot_edges_[k - 1].top_x < se.top_x - 1)
+          CheckEdges(*bot_edges_[k - 1].edge, *se.edge);
+    }
+    std::sort(pairs_.begin(), pairs_.end(), EdgePairLess);
+    std::swap(pairs_, prev_pairs_);
+
+    //horizontals at the bottom of the scanbeam meet the edges that are there,
+    //and those at the top meet the edges that end there (since the rest are
+    //at the bottom of the next scanbeam) ...
+    HorzEdge key;
+    key.y = bot_y;
+    key.left = std::numeric_limits< int64_t >::min();
+    std::vector< HorzEdge >::const_iterator h =
+      std::lower_bound(horz_edges_.begin(), horz_edges_.end(), key, HorzLess);
+    for ( ; h != horz_edges_.end() && h->y == bot_y; ++h) {
+      ScanEdge se;
+      se.bot_x = h->left - 1;
+      std::vector< ScanEdge >::const_iterator e = 
+        std::lower_bound(bot_edges_.begin(), bot_edges_.end(), se, BotXLess);
+      for ( ; e != bot_edges_.end() && e->bot_x <= h->right + 1; ++e)
+        CheckHorizontal(*h, *e->edge);
+    }
+    for ( ; h != horz_edges_.end() && h->y > top_y; ++h) ;
+    for ( ; h != horz_edges_.end() && h->y == top_y; ++h) {
+      //nb: top_edges_ is sorted on top_x (which is exact where edges end)
+      size_t lo = 0, hi = top_edges_.size();
+      while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (top_edges_[mid].top_x < h->left) lo = mid + 1; else hi = mid;
+      }
+      for ( ; lo < top_edges_.size() && top_edges_[lo].top_x <= h->right; ++lo)
+        if (top_edges_[lo].edge->top.y == top_y)
+          CheckHorizontal(*h, *top_edges_[lo].edge);
+    }
+  }
+  //------------------------------------------------------------------------------
+
+  bool ClipperSelfIntersect::Execute(Path *intersections)
+  {
+    intersections_ = intersections;
+    stop_at_first_ = !intersections;
+    if (intersections) intersections->clear();
+    found_ = false;
+    for (Path::const_iterator it = spikes_.begin(); it != spikes_.end(); ++it)
+      AddIntersection(*it);
+    if (!found_ || !stop_at_first_) CheckHorizontals();
+    if (!found_ || !stop_at_first_) {
+      prev_pairs_.clear();
+      ExecuteInternal(ctUnion, frEvenOdd);
+      CleanUp();
+    }
+    intersections_ = NULL;
+    return found_;
+  }
+  //------------------------------------------------------------------------------
+
+  //------------------------------------------------------------------------------
+  // Predicates ...
+  //------------------------------------------------------------------------------
+
+  bool IsSimple(const Path &path)
+  {
+    ClipperSelfIntersect c;
+    c.AddPath(path, ptSubject);
+    return !c.Execute(NULL);
+  }
+  //------------------------------------------------------------------------------
+
+  bool IsSimple(const Paths &paths)
+  {
+    ClipperSelfIntersect c;
+    c.AddPaths(paths, ptSubject);
+    return !c.Execute(NULL);
+  }
+  //------------------------------------------------------------------------------
+
+  void FindSelfIntersections(const Paths &paths, Path &intersections)
+  {
+    ClipperSelfIntersect c;
+    c.AddPaths(paths, ptSubject);
+    c.Execute(&intersections);
+  }
+  //------------------------------------------------------------------------------
+
+  bool IsSimple(const Paths &paths, ClipperSelfIntersect &engine)
+  {
+    engine.Clear();
+    engine.AddPaths(paths, ptSubject);
+    return !engine.Execute(NULL);
+  }
+  //------------------------------------------------------------------------------
+
+  void FindSelfIntersections(const Paths &paths, Path &intersections, 
+    ClipperSelfIntersect &engine)
+  {
+    engine.Clear();
+    engine.AddPaths(paths, ptSubject);
+    engine.Execute(&intersections);
+  }
+  //------------------------------------------------------------------------------
+
+  bool Intersects(const Paths &subject, const Paths &clip, FillRule fr)
+  {
+    Rect64 r1 = GetPathsBounds(subject), r2 = GetPathsBounds(clip);
+    if (IsEmptyRect(r1) || IsEmptyRect(r2) || !RectsOverlap(r1, r2)) return false;
+    ClipperPredicate c;
+    c.AddPaths(subject, ptSubject);
+    c.AddPaths(clip, ptClip);
+    bool is_empty;
+    return c.Execute(ctIntersection, is_empty, fr) && !is_empty;
+  }
+  //------------------------------------------------------------------------------
+
+  bool Disjoint(const Paths &subject, const Paths &clip, FillRule fr)
+  {
+    return !Intersects(subject, clip, fr);
+  }
+  //------------------------------------------------------------------------------
+
+  bool Contains(const Paths &outer, const Paths &inner, FillRule fr)
+  {
+    Rect64 r1 = GetPathsBounds(outer), r2 = GetPathsBounds(inner);
+    if (IsEmptyRect(r2)) return true;
+    //With frPositive and frNegative, paths wound the other way fill nothing,
+    //so inner's vertices needn't touch its filled region and the quick tests
+    //below are only used with frEvenOdd and frNonZero ...
+    if (fr == frEvenOdd || fr == frNonZero) {
+      if (IsEmptyRect(r1) || !RectContains(r1, r2)) return false;
+      //a vertex of inner that's strictly outside outer settles it quickly ...
+      for (Paths::const_iterator p = inner.begin(); p != inner.end(); ++p)
+        if (p->size() > 2) {
+          if (PointInPaths((*p)[0], outer, fr) == pirOutside) return false;
+          break;
+        }
+    }
+    //otherwise inner is contained only when (inner - outer) is empty ...
+    ClipperPredicate c;
+    c.AddPaths(inner, ptSubject);
+    c.AddPaths(outer, ptClip);
+    bool is_empty;
+    return c.Execute(ctDifference, is_empty, fr) && is_empty;
+  }
+  //------------------------------------------------------------------------------
+
+} //namespace
@@ -0,0 +1,140 @@
+/*******************************************************************************
+* Author    :  Angus Johnson                                                   *
+* Version   :  10.0 (beta)                                                     *
+* Date      :  8 November 2017                                                 *
+* Website   :  http://www.angusj.com                                           *
+* Copyright :  Angus Johnson 2010-2017                                         *
+* Purpose   :  Yes/no spatial predicates that stop the sweep as soon as known  *
+* License   :  http://www.boost.org/LICENSE_1_0.txt                            *
+*******************************************************************************/
+
+#ifndef clipper_predicates_h
+#define clipper_predicates_h
+
+#include <vector>
+#include <cstdlib>
+#include "clipper.h"
+
+namespace clipperlib {
+
+  //ClipperPredicate: a Clipper that stops as soon as it's clear that the 
+  //solution won't be empty, so it only answers whether the solution is empty.
+  class ClipperPredicate : public virtual Clipper
+  {
+  private:
+    bool found_;
+  protected:
+    OutPt* AddOutPt(Active &e, const Point64 pt);
+    void AddLocalMaxPoly(Active &e1, Active &e2, const Point64 pt);
+  public:
+    explicit ClipperPredicate(MemoryResource *mr = NULL) : Clipper(mr) {}
+    bool Execute(ClipType clipType, bool &is_empty, FillRule fr = frEvenOdd);
+    bool Execute(ClipType /*clipType*/, Paths &/*solution_closed*/, FillRule /*fr*/ = frEvenOdd)
+      { return false; } //use Clipper for the solution's paths
+    bool Execute(ClipType /*clipType*/, Paths &/*solution_closed*/, Paths &/*solution_open*/, 
+      FillRule /*fr*/ = frEvenOdd) { return false; }
+    bool Execute(ClipType /*clipType*/, PolyTree &/*solution_closed*/, Paths &/*solution_open*/, 
+      FillRule /*fr*/ = frEvenOdd) { return false; }
+  };
+
+  //ClipperSelfIntersect: sweeps its (subject) paths only to find where their 
+  //edges cross or touch. In each scanbeam, the edges that aren't clearly apart
+  //at both its bottom and top are checked with an exact (integer) segment
+  //intersection test, as are the horizontal edges at either end of it. 'Spikes'
+  //(where a path doubles back over its previous edge) and vertices that a path
+  //visits twice are found as paths are added. No solution paths are built.
+  //Where edges overlap, or touch at a vertex shared by several edges, the same
+  //point may be listed more than once. (The tests are exact provided that the
+  //differences between coordinates fit in an int64_t.)
+  class ClipperSelfIntersect : public virtual Clipper
+  {
+  private:
+    struct ScanEdge {
+      int64_t bot_x;  //where the edge is at the bottom of the scanbeam
+      int64_t top_x;  //and at the top (both rounded)
+      const Active *edge;
+    };
+    struct HorzEdge {
+      int64_t y;
+      int64_t left;
+      int64_t right;
+      int path_id;
+    };
+    struct EdgePair {
+      const Vertex *top1;
+      const Vertex *top2;
+      int dir1;
+      int dir2;
+    };
+    std::vector< ScanEdge > bot_edges_;  //sorted on bot_x
+    std::vector< ScanEdge > top_edges_;  //sorted on top_x
+    std::vector< HorzEdge > horz_edges_;
+    std::vector< EdgePair > pairs_;      //pairs found in this scanbeam
+    std::vector< EdgePair > prev_pairs_; //and in the previous one
+    Path spikes_;
+    Path path_pts_;
+    Path *intersections_;
+    bool stop_at_first_;
+    bool found_;
+    void AddIntersection(const Point64 &pt);
+    void CheckEdges(const Active &e1, const Active &e2);
+    void CheckHorizontal(const HorzEdge &horz, const Active &e);
+    void CheckHorizontals();
+    static bool BotXLess(const ScanEdge &a, const ScanEdge &b);
+    static bool HorzLess(const HorzEdge &a, const HorzEdge &b);
+    static bool EdgePairLess(const EdgePair &a, const EdgePair &b);
+  protected:
+    OutPt* AddOutPt(Active &/*e*/, const Point64 /*pt*/) { return NULL; }
+    void AddLocalMinPoly(Active &/*e1*/, Active &/*e2*/, const Point64 /*pt*/) {}
+    void AddLocalMaxPoly(Active &/*e1*/, Active &/*e2*/, const Point64 /*pt*/) {}
+    void IntersectEdges(Active &e1, Active &e2, const Point64 pt);
+    void DoScanbeam(const int64_t bot_y, const int64_t top_y);
+  public:
+    explicit ClipperSelfIntersect(MemoryResource *mr = NULL): Clipper(mr), 
+      intersections_(NULL), stop_at_first_(false), found_(false) {}
+    void AddPath(const Path &path, PathType polytype, bool is_open = false);
+    void Clear() { spikes_.clear(); horz_edges_.clear(); Clipper::Clear(); }
+    //nb: a blob doesn't hold horz_edges_ or spikes_
+    void LoadPrepared(const char * /*blob*/, size_t /*size*/)
+      { throw ClipperException("ClipperSelfIntersect: LoadPrepared isn't supported."); }
+    //Execute: returns true when an intersection is found. If intersections is
+    //NULL, the sweep stops at the first intersection.
+    bool Execute(Path *intersections);
+    bool Execute(ClipType /*clipType*/, Paths &/*solution_closed*/, FillRule /*fr*/ = frEvenOdd)
+      { return false; } //use Clipper for the solution's paths
+    bool Execute(ClipType /*clipType*/, Paths &/*solution_closed*/, Paths &/*solution_open*/, 
+      FillRule /*fr*/ = frEvenOdd) { return false; }
+    bool Execute(ClipType /*clipType*/, PolyTree &/*solution_closed*/, Paths &/*solution_open*/, 
+      FillRule /*fr*/ = frEvenOdd) { return false; }
+  };
+
+  //IsSimple: true when no edges cross or touch (other than adjacent edges at
+  //their shared vertex).
+  bool IsSimple(const Path &path);
+  bool IsSimple(const Paths &paths);
+  //FindSelfIntersections: where edges of paths (and of different paths) cross
+  //or touch.
+  void FindSelfIntersections(const Paths &paths, Path &intersections);
+  //These overloads Clear and reuse engine, whose buffers are kept from one call
+  //to the next. Its vertices, edges etc come from its MemoryResource, so with
+  //a resource that recycles memory, calls needn't allocate once warmed up.
+  bool IsSimple(const Paths &paths, ClipperSelfIntersect &engine);
+  void FindSelfIntersections(const Paths &paths, Path &intersections, 
+    ClipperSelfIntersect &engine);
+
+  //GetPathsBounds: the bounding rectangle of all the vertices in paths.
+  Rect64 GetPathsBounds(const Paths &paths);
+
+  //Intersects: true when the filled regions of subject and clip overlap.
+  //(Regions that only touch along their edges or at vertices don't overlap.)
+  bool Intersects(const Paths &subject, const Paths &clip, FillRule fr = frEvenOdd);
+  bool Disjoint(const Paths &subject, const Paths &clip, FillRule fr = frEvenOdd);
+  //Contains: true when every part of inner's filled region is also in outer's.
+  //(With frEvenOdd and frNonZero, the quick rejection tests assume that inner's
+  //vertices all touch its filled region, ie that inner has no degenerate or 
+  //self-cancelling paths. With frPositive and frNegative they're skipped.)
+  bool Contains(const Paths &outer, const Paths &inner, FillRule fr = frEvenOdd);
+
+} //namespace
+
+#endif //clipper_predicates_h
@@ -0,0 +1,171 @@
+/*******************************************************************************
+* Author    :  Angus Johnson                                                   *
+* Version   :  10.0 (beta)                                                     *
+* Date      :  8 November 2017                                                 *
+* Website   :  http://www.angusj.com                                           *
+* Copyright :  Angus Johnson 2010-2017                                         *
+* Purpose   :  Clipping solutions that record each edge's source path          *
+* License   :  http://www.boost.org/LICENSE_1_0.txt                            *
+*******************************************************************************/
+
+#include <stdlib.h>
+#include "clipper_provenance.h"
+#include "clipper.h"
+
+namespace clipperlib {
+
+  //------------------------------------------------------------------------------
+  // Miscellaneous functions (static, as other modules have their own) ...
+  //------------------------------------------------------------------------------
+
+  static inline bool IsHotEdge(const Active &e) { return (e.outrec); }
+  //------------------------------------------------------------------------------
+
+  static inline bool IsStartSide(const Active &e) { return (&e == e.outrec->start_e); }
+  //------------------------------------------------------------------------------
+
+  static inline int PointCount(OutPt *op)
+  {
+    if (!op) return 0;
+    OutPt *p = op;
+    int cnt = 0;
+    do {
+      cnt++;
+      p = p->next;
+    } while (p != op);
+    return cnt;
+  }
+  //------------------------------------------------------------------------------
+
+  //------------------------------------------------------------------------------
+  // ClipperProvenance methods ...
+  //------------------------------------------------------------------------------
+
+  OutPt* ClipperProvenance::CreateOutPt()
+  {
+    OutPtSrc *result = new (outpt_arena_.Alloc()) OutPtSrc();
+    result->src = -1;
+    last_op_ = result;
+    return result;
+  }
+  //------------------------------------------------------------------------------
+
+  OutPt* ClipperProvenance::AddOutPt(Active &e, const Point64 pt)
+  {
+    //new vertices go between the start and end vertices (ie into the gap). On
+    //the start side the edge from start_op to the new vertex lies along e and
+    //the gap moves on, otherwise the edge from the new vertex to end_op does.
+    OutPtSrc *start_op = static_cast<OutPtSrc*>(e.outrec->pts);
+    OutPt *end_op = start_op->next;
+    bool to_start = IsStartSide(e);
+    OutPtSrc *result = static_cast<OutPtSrc*>(Clipper::AddOutPt(e, pt));
+    last_op_ = result;
+    if (result == start_op || result == end_op) return result; //duplicate
+    if (to_start) start_op->src = e.path_id;
+    else result->src = e.path_id;
+    return result;
+  }
+  //------------------------------------------------------------------------------
+
+  void ClipperProvenance::AddLocalMaxPoly(Active &e1, Active &e2, const Point64 pt)
+  {
+    //e1 adds the vertex at pt, but the edge that then closes (or joins) the gap
+    //between pt and e2's last vertex lies along e2 ...
+    OutPtSrc *op2 = NULL;
+    if (IsHotEdge(e2)) op2 = static_cast<OutPtSrc*>(
+      IsStartSide(e2) ? e2.outrec->pts : e2.outrec->pts->next);
+    OutRec *outrec1 = e1.outrec, *outrec2 = e2.outrec;
+    Clipper::AddLocalMaxPoly(e1, e2, pt);
+    OutPtSrc *op1 = last_op_;
+    if (!op2 || op1 == op2) return;
+    //after joining, the new gap mustn't be mistaken for e2's edge ...
+    OutPt *gap = NULL;
+    if (outrec1 != outrec2) gap = outrec1->pts ? outrec1->pts : outrec2->pts;
+    if (op1->next == op2 && op1 != gap) op1->src = e2.path_id;
+    else if (op2->next == op1 && op2 != gap) op2->src = e2.path_id;
+  }
+  //------------------------------------------------------------------------------
+
+  void ClipperProvenance::AddPath(const Path &path, PathType polytype, bool is_open)
+  {
+    Clipper::AddPath(path, polytype, is_open);
+    path_types_.push_back(polytype);
+  }
+  //------------------------------------------------------------------------------
+
+  void ClipperProvenance::BuildResult(Paths &solution_closed, PathsIds &ids_closed,
+    Paths *solution_open, PathsIds *ids_open)
+  {
+    //nb: this mirrors Clipper::BuildResult so paths are returned in the same
+    //order and with the same vertices.
+    solution_closed.resize(0);
+    ids_closed.resize(0);
+    if (solution_open) {
+      solution_open->resize(0);
+      ids_open->resize(0);
+    }
+
+    OutRecList &outrecs = outrec_list();
+    for (OutRecList::const_iterator ol_iter = outrecs.begin();
+      ol_iter != outrecs.end(); ++ol_iter)
+    {
+      OutRec *outrec = *ol_iter;
+      if (!outrec->pts) continue;
+      OutPt *op = outrec->pts->next;
+      int cnt = PointCount(op);
+      //fixup for duplicate start and end points ...
+      if (op->pt == outrec->pts->pt) cnt--;
+
+      bool is_open = (outrec->flag == orOpen);
+      if (cnt < 2 || (!is_open && cnt == 2) || (is_open && !solution_open)) continue;
+      Path p;
+      PathIds ids;
+      p.reserve(cnt);
+      ids.reserve(cnt);
+      for (int i = 0; i < cnt; i++) {
+        p.push_back(op->pt);
+        ids.push_back(static_cast<OutPtSrc*>(op)->src);
+        op = op->next;
+      }
+      if (is_open) {
+        ids[cnt - 1] = -1;
+        solution_open->push_back(p);
+        ids_open->push_back(ids);
+      }
+      else {
+        solution_closed.push_back(p);
+        ids_closed.push_back(ids);
+      }
+    }
+  }
+  //------------------------------------------------------------------------------
+
+  bool ClipperProvenance::Execute(ClipType clipType, Paths &solution_closed,
+    PathsIds &ids_closed, FillRule fr)
+  {
+    solution_closed.clear();
+    ids_closed.clear();
+    bool result = ExecuteInternal(clipType, fr);
+    if (result) BuildResult(solution_closed, ids_closed, NULL, NULL);
+    CleanUp();
+    outpt_arena_.Clear();
+    return result;
+  }
+  //------------------------------------------------------------------------------
+
+  bool ClipperProvenance::Execute(ClipType clipType, Paths &solution_closed,
+    PathsIds &ids_closed, Paths &solution_open, PathsIds &ids_open, FillRule fr)
+  {
+    solution_closed.clear();
+    ids_closed.clear();
+    solution_open.clear();
+    ids_open.clear();
+    bool result = ExecuteInternal(clipType, fr);
+    if (result) BuildResult(solution_closed, ids_closed, &solution_open, &ids_open);
+    CleanUp();
+    outpt_arena_.Clear();
+    return result;
+  }
+  //------------------------------------------------------------------------------
+
+} //namespace
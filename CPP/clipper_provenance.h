@@ -0,0 +1,68 @@
+/*******************************************************************************
+* Author    :  Angus Johnson                                                   *
+* Version   :  10.0 (beta)                                                     *
+* Date      :  8 November 2017                                                 *
+* Website   :  http://www.angusj.com                                           *
+* Copyright :  Angus Johnson 2010-2017                                         *
+* Purpose   :  Clipping solutions that record each edge's source path          *
+* License   :  http://www.boost.org/LICENSE_1_0.txt                            *
+*******************************************************************************/
+
+#ifndef clipper_provenance_h
+#define clipper_provenance_h
+
+#include <vector>
+#include "clipper.h"
+
+namespace clipperlib {
+
+  //PathIds: one id for each vertex of a solution path, where ids[i] is the
+  //input path that the edge from path[i] to path[i+1] came from. (The last id
+  //of a closed path is for its closing edge, and the last id of an open path
+  //is always -1.) Input paths are numbered from 0 in the order they're added.
+  //Very occasionally an id is -1 where a path's orientation had to be fixed
+  //while joining (see Clipper::FixOrientation) and its source is unknown.
+  typedef std::vector< int > PathIds;
+  typedef std::vector< PathIds > PathsIds;
+
+  //OutPtSrc: src is the input path of the edge from this vertex to next
+  //(and it's -1 for the gap between the ends of a path that's still open).
+  class OutPtSrc : public OutPt
+  {
+  public:
+    int src;
+  };
+
+  //ClipperProvenance: a Clipper that also returns the source of every edge in
+  //the solution. Only this class carries the extra per-vertex id, so Clipper
+  //itself is unaffected.
+  class ClipperProvenance : public virtual Clipper
+  {
+  private:
+    OutPtSrc *last_op_;
+    MemArena outpt_arena_;
+    std::vector< PathType > path_types_;
+    void BuildResult(Paths &solution_closed, PathsIds &ids_closed,
+      Paths *solution_open, PathsIds *ids_open);
+  protected:
+    OutPt* CreateOutPt();
+    OutPt* AddOutPt(Active &e, const Point64 pt);
+    void AddLocalMaxPoly(Active &e1, Active &e2, const Point64 pt);
+  public:
+    explicit ClipperProvenance(MemoryResource *mr = NULL) : Clipper(mr), 
+      last_op_(NULL), outpt_arena_(sizeof(OutPtSrc), mr) {}
+    void AddPath(const Path &path, PathType polytype, bool is_open = false);
+    void Clear() { path_types_.clear(); Clipper::Clear(); }
+    //nb: a blob doesn't hold path_types_
+    void LoadPrepared(const char * /*blob*/, size_t /*size*/)
+      { throw ClipperException("ClipperProvenance: LoadPrepared isn't supported."); }
+    PathType GetPathType(int path_id) const { return path_types_[path_id]; }
+    bool Execute(ClipType clipType, Paths &solution_closed, PathsIds &ids_closed,
+      FillRule fr = frEvenOdd);
+    bool Execute(ClipType clipType, Paths &solution_closed, PathsIds &ids_closed,
+      Paths &solution_open, PathsIds &ids_open, FillRule fr = frEvenOdd);
+  };
+
+} //namespace
+
+#endif //clipper_provenance_h
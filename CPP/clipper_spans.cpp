@@ -0,0 +1,135 @@
+/*******************************************************************************
+* Author    :  Angus Johnson                                                   *
+* Version   :  10.0 (beta)                                                     *
+* Date      :  8 November 2017                                                 *
+* Website   :  http://www.angusj.com                                           *
+* Copyright :  Angus Johnson 2010-2017                                         *
+* Purpose   :  Clipping solutions as horizontal spans of pixels (rasterizing)  *
+* License   :  http://www.boost.org/LICENSE_1_0.txt                            *
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <cmath>
+#include <vector>
+#include "clipper_spans.h"
+#include "clipper.h"
+
+namespace clipperlib {
+
+  //------------------------------------------------------------------------------
+  // Miscellaneous functions ...
+  //------------------------------------------------------------------------------
+
+  inline bool IsHorizontal(const Active &e) { return (e.dx == CLIPPER_HORIZONTAL); }
+  //------------------------------------------------------------------------------
+
+  inline bool IsFilledBy(int wind_cnt, FillRule fr)
+  {
+    switch (fr) {
+      case frEvenOdd: return (wind_cnt & 1) != 0;
+      case frNonZero: return wind_cnt != 0;
+      case frPositive: return wind_cnt > 0;
+      default: return wind_cnt < 0;
+    }
+  }
+  //------------------------------------------------------------------------------
+
+  //the first pixel whose centre is at or right of x ...
+  inline int64_t PixelAt(double x) { return int64_t(std::ceil(x - 0.5)); }
+  //------------------------------------------------------------------------------
+
+  // ClipperSpans methods ...
+  //------------------------------------------------------------------------------
+
+  inline bool ClipperSpans::IsFilled(int wind_cnt, int wind_cnt2) const
+  {
+    //wind_cnt is the subject's winding count and wind_cnt2 is the clip's
+    bool subj = IsFilledBy(wind_cnt, fill_rule_), clip = IsFilledBy(wind_cnt2, fill_rule_);
+    switch (clip_type_) {
+      case ctIntersection: return subj && clip;
+      case ctUnion: return subj || clip;
+      case ctDifference: return subj && !clip;
+      case ctXor: return subj != clip;
+      default: return false;
+    }
+  }
+  //------------------------------------------------------------------------------
+
+  void ClipperSpans::AddSpan(const int64_t y, const int64_t left, const int64_t right)
+  {
+    spans_->push_back(ScanSpan(y, left, right));
+  }
+  //------------------------------------------------------------------------------
+
+  void ClipperSpans::DoScanbeam(const int64_t bot_y, const int64_t top_y)
+  {
+    //the AEL is ordered at bot_y and every edge in it reaches up to top_y, so
+    //sample each row of pixels in between at its centre ...
+    edges_.clear();
+    for (const Active *e = actives(); e; e = e->next_in_ael) {
+      if (e->is_open || IsHorizontal(*e)) continue;
+      EdgeX ex;
+      ex.x = 0;
+      ex.edge = e;
+      edges_.push_back(ex);
+    }
+    if (edges_.empty()) return;
+    for (int64_t y = bot_y - 1; y >= top_y; --y) DoRow(y);
+  }
+  //------------------------------------------------------------------------------
+
+  void ClipperSpans::DoRow(const int64_t y)
+  {
+    double row_y = double(y) + 0.5;
+    for (EdgeXList::iterator it = edges_.begin(); it != edges_.end(); ++it)
+      it->x = double(it->edge->bot.x) + it->edge->dx * (row_y - double(it->edge->bot.y));
+
+    //edges only swap places where they intersect, so they're almost always 
+    //still ordered from the previous row (and an insertion sort is ideal) ...
+    for (size_t i = 1; i < edges_.size(); ++i) {
+      if (edges_[i - 1].x <= edges_[i].x) continue;
+      EdgeX ex = edges_[i];
+      size_t j = i;
+      for (; j > 0 && edges_[j - 1].x > ex.x; --j) edges_[j] = edges_[j - 1];
+      edges_[j] = ex;
+    }
+
+    int wind_cnt = 0, wind_cnt2 = 0;
+    bool is_filled = false;
+    int64_t left = 0, right = 0;
+    bool has_span = false;
+    for (EdgeXList::const_iterator it = edges_.begin(); it != edges_.end(); ++it) {
+      if (it->edge->polytype == ptSubject) wind_cnt += it->edge->wind_dx;
+      else wind_cnt2 += it->edge->wind_dx;
+      bool was_filled = is_filled;
+      is_filled = IsFilled(wind_cnt, wind_cnt2);
+      if (is_filled == was_filled) continue;
+      int64_t x = PixelAt(it->x);
+      if (is_filled) {
+        //start a span, unless the last span ended here (when it's extended)
+        if (!has_span || x > right) {
+          if (has_span && left < right) AddSpan(y, left, right);
+          left = x;
+          has_span = true;
+        }
+      }
+      else right = x;
+    }
+    if (has_span && left < right) AddSpan(y, left, right);
+  }
+  //------------------------------------------------------------------------------
+
+  bool ClipperSpans::Execute(ClipType clipType, ScanSpans &spans, FillRule fr)
+  {
+    spans.clear();
+    spans_ = &spans;
+    clip_type_ = clipType;
+    fill_rule_ = fr;
+    bool result = ExecuteInternal(clipType, fr);
+    CleanUp();
+    spans_ = NULL;
+    return result;
+  }
+  //------------------------------------------------------------------------------
+
+} //namespace
@@ -0,0 +1,70 @@
+/*******************************************************************************
+* Author    :  Angus Johnson                                                   *
+* Version   :  10.0 (beta)                                                     *
+* Date      :  8 November 2017                                                 *
+* Website   :  http://www.angusj.com                                           *
+* Copyright :  Angus Johnson 2010-2017                                         *
+* Purpose   :  Clipping solutions as horizontal spans of pixels (rasterizing)  *
+* License   :  http://www.boost.org/LICENSE_1_0.txt                            *
+*******************************************************************************/
+
+#ifndef clipper_spans_h
+#define clipper_spans_h
+
+#include <vector>
+#include <cstdlib>
+#include "clipper.h"
+
+namespace clipperlib {
+
+  //ScanSpan: the pixels from left up to (but excluding) right in row y.
+  struct ScanSpan {
+    int64_t y;
+    int64_t left;
+    int64_t right;
+    ScanSpan(int64_t y_ = 0, int64_t l = 0, int64_t r = 0): y(y_), left(l), right(r) {}
+  };
+
+  typedef std::vector< ScanSpan > ScanSpans;
+
+  //ClipperSpans: returns the solution's filled region as spans of pixels, where
+  //pixel (x, y) is filled when its centre (x + 0.5, y + 0.5) is. The spans of
+  //each scanbeam come straight from the AEL (using the ClipType and FillRule's
+  //winding logic) so the solution's paths are never built. Spans are ordered 
+  //by descending y (ie the order of the sweep) and then by ascending x.
+  class ClipperSpans : public virtual Clipper
+  {
+  private:
+    struct EdgeX {
+      double x;
+      const Active *edge;
+    };
+    typedef std::vector< EdgeX > EdgeXList;
+    EdgeXList edges_;
+    ScanSpans *spans_;
+    ClipType clip_type_;
+    FillRule fill_rule_;
+    inline bool IsFilled(int wind_cnt, int wind_cnt2) const;
+    void DoRow(const int64_t y);
+  protected:
+    OutPt* AddOutPt(Active &/*e*/, const Point64 /*pt*/) { return NULL; }
+    void AddLocalMinPoly(Active &/*e1*/, Active &/*e2*/, const Point64 /*pt*/) {}
+    void AddLocalMaxPoly(Active &/*e1*/, Active &/*e2*/, const Point64 /*pt*/) {}
+    void DoScanbeam(const int64_t bot_y, const int64_t top_y);
+    //AddSpan: override to stream spans rather than collect them.
+    virtual void AddSpan(const int64_t y, const int64_t left, const int64_t right);
+  public:
+    explicit ClipperSpans(MemoryResource *mr = NULL): Clipper(mr), spans_(NULL), 
+      clip_type_(ctNone), fill_rule_(frEvenOdd) {}
+    bool Execute(ClipType clipType, ScanSpans &spans, FillRule fr = frEvenOdd);
+    bool Execute(ClipType /*clipType*/, Paths &/*solution_closed*/, FillRule /*fr*/ = frEvenOdd)
+      { return false; } //use Clipper for the solution's paths
+    bool Execute(ClipType /*clipType*/, Paths &/*solution_closed*/, Paths &/*solution_open*/, 
+      FillRule /*fr*/ = frEvenOdd) { return false; }
+    bool Execute(ClipType /*clipType*/, PolyTree &/*solution_closed*/, Paths &/*solution_open*/, 
+      FillRule /*fr*/ = frEvenOdd) { return false; }
+  };
+
+} //namespace
+
+#endif //clipper_spans_h
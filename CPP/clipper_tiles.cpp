@@ -0,0 +1,244 @@
+/*******************************************************************************
+* Author    :  Angus Johnson                                                   *
+* Version   :  10.0 (beta)                                                     *
+* Date      :  8 November 2017                                                 *
+* Website   :  http://www.angusj.com                                           *
+* Copyright :  Angus Johnson 2010-2017                                         *
+* Purpose   :  Cuts polygons into the tiles of a regular grid (in one pass)    *
+* License   :  http://www.boost.org/LICENSE_1_0.txt                            *
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include "clipper_tiles.h"
+#include "clipper.h"
+
+namespace clipperlib {
+
+  //CutJob: the two halves of a sub-grid, cut in parallel (see CutTiles) ...
+  struct TileCutter::CutJob : public WorkerJob {
+    TileCutter *owner;
+    Paths      *paths[2];
+    int64_t     col1[2], col2[2], row1[2], row2[2];
+    Tiles      *tiles[2];
+    unsigned    thread_cnt[2];
+  };
+
+  //------------------------------------------------------------------------------
+  // Miscellaneous functions ...
+  //------------------------------------------------------------------------------
+
+  inline int64_t FloorDiv(int64_t a, int64_t b)
+  {
+    int64_t q = a / b;
+    return (a % b && a < 0) ? q - 1 : q;
+  }
+  //------------------------------------------------------------------------------
+
+  inline int64_t Round(double val)
+  {
+    if ((val < 0)) return static_cast<int64_t>(val - 0.5);
+    else return static_cast<int64_t>(val + 0.5);
+  }
+  //------------------------------------------------------------------------------
+
+  inline bool TileLess(const Tile &a, const Tile &b)
+  {
+    if (a.row != b.row) return a.row < b.row;
+    return a.col < b.col;
+  }
+  //------------------------------------------------------------------------------
+
+  inline void AppendPt(Path &path, const Point64 &pt)
+  {
+    if (path.empty() || path.back() != pt) path.push_back(pt);
+  }
+  //------------------------------------------------------------------------------
+
+  //CutPath: keeps the part of path that's on one side of the line X = at (or 
+  //Y = at when is_horz), ie where X <= at when keep_below, else where X >= at.
+  static void CutPath(const Path &path, bool is_horz, int64_t at, bool keep_below,
+    Path &result)
+  {
+    result.clear();
+    size_t cnt = path.size();
+    if (cnt < 3) return;
+    const Point64 *prev = &path[cnt - 1];
+    int64_t prev_d = (is_horz ? prev->y : prev->x) - at;
+    if (!keep_below) prev_d = -prev_d;
+    bool all_on_line = true;
+    for (size_t i = 0; i < cnt; ++i) {
+      const Point64 *curr = &path[i];
+      int64_t curr_d = (is_horz ? curr->y : curr->x) - at;
+      if (!keep_below) curr_d = -curr_d;
+      if ((curr_d < 0 && prev_d > 0) || (curr_d > 0 && prev_d < 0)) {
+        //add where prev->curr crosses the line (exactly on the line, so that
+        //both neighbouring tiles get the same point) ...
+        double t = double(prev_d) / double(prev_d - curr_d);
+        if (is_horz)
+          AppendPt(result, Point64(prev->x + Round((curr->x - prev->x) * t), at));
+        else
+          AppendPt(result, Point64(at, prev->y + Round((curr->y - prev->y) * t)));
+      }
+      if (curr_d <= 0) {
+        AppendPt(result, *curr);
+        if (curr_d < 0) all_on_line = false;
+      }
+      prev = curr;
+      prev_d = curr_d;
+    }
+    while (result.size() > 1 && result.back() == result.front()) result.pop_back();
+    if (result.size() < 3 || all_on_line) result.clear(); //ie no area
+  }
+  //------------------------------------------------------------------------------
+
+  static void CutPaths(const Paths &paths, bool is_horz, int64_t at, bool keep_below,
+    Paths &result)
+  {
+    result.clear();
+    result.reserve(paths.size());
+    Path p;
+    for (Paths::const_iterator it = paths.begin(); it != paths.end(); ++it) {
+      CutPath(*it, is_horz, at, keep_below, p);
+      if (p.empty()) continue;
+      result.push_back(Path());
+      result.back().swap(p);
+    }
+  }
+  //------------------------------------------------------------------------------
+
+  // TileCutter methods ...
+  //------------------------------------------------------------------------------
+
+  TileCutter::TileCutter(const Point64 &origin, int64_t tile_size, unsigned level,
+    int64_t margin) : origin_(origin), margin_(margin)
+  {
+    tile_size_ = level < 63 ? tile_size >> level : 0;
+    if (tile_size_ <= 0) throw ClipperException("TileCutter: invalid tile size.");
+    if (margin_ < 0) throw ClipperException("TileCutter: invalid margin.");
+  }
+  //------------------------------------------------------------------------------
+
+  void TileCutter::AddPath(const Path &path)
+  {
+    if (path.size() > 2) paths_.push_back(path);
+  }
+  //------------------------------------------------------------------------------
+
+  void TileCutter::AddPaths(const Paths &paths)
+  {
+    for (Paths::const_iterator it = paths.begin(); it != paths.end(); ++it)
+      AddPath(*it);
+  }
+  //------------------------------------------------------------------------------
+
+  Rect64 TileCutter::TileRect(int64_t col, int64_t row) const
+  {
+    int64_t l = origin_.x + col * tile_size_, t = origin_.y + row * tile_size_;
+    return Rect64(l, t, l + tile_size_, t + tile_size_);
+  }
+  //------------------------------------------------------------------------------
+
+  void TileCutter::CutTiles(Paths &paths, int64_t col1, int64_t col2,
+    int64_t row1, int64_t row2, Tiles &tiles, unsigned thread_cnt)
+  {
+    //paths will be within the tiles from col1 to col2 and row1 to row2 (both
+    //exclusive of the '2's) so cut them in half along a grid line, then recurse
+    if (paths.empty()) return;
+    if (col2 - col1 == 1 && row2 - row1 == 1) {
+      tiles.push_back(Tile());
+      tiles.back().col = col1;
+      tiles.back().row = row1;
+      tiles.back().paths.swap(paths);
+      return;
+    }
+    bool is_horz = (row2 - row1 > col2 - col1);
+    int64_t mid, at;
+    if (is_horz) {
+      mid = row1 + (row2 - row1) / 2;
+      at = origin_.y + mid * tile_size_;
+    } else {
+      mid = col1 + (col2 - col1) / 2;
+      at = origin_.x + mid * tile_size_;
+    }
+    Paths below, above;
+    CutPaths(paths, is_horz, at + margin_, true, below);
+    CutPaths(paths, is_horz, at - margin_, false, above);
+    Paths().swap(paths); //no longer needed
+
+    if (thread_cnt > 1) {
+      //cut the two halves in parallel, with 'below' into its own tiles ...
+      Tiles below_tiles;
+      CutJob job;
+      job.owner = this;
+      job.paths[0] = &below;
+      job.col1[0] = col1;
+      job.col2[0] = is_horz ? col2 : mid;
+      job.row1[0] = row1;
+      job.row2[0] = is_horz ? mid : row2;
+      job.tiles[0] = &below_tiles;
+      job.thread_cnt[0] = thread_cnt / 2;
+      job.paths[1] = &above;
+      job.col1[1] = is_horz ? col1 : mid;
+      job.col2[1] = col2;
+      job.row1[1] = is_horz ? mid : row1;
+      job.row2[1] = row2;
+      job.tiles[1] = &tiles;
+      job.thread_cnt[1] = thread_cnt - thread_cnt / 2;
+      RunWorkers(job, CutWorker, 2, 2);
+      tiles.reserve(tiles.size() + below_tiles.size());
+      for (Tiles::iterator it = below_tiles.begin(); it != below_tiles.end(); ++it) {
+        tiles.push_back(Tile());
+        tiles.back().col = it->col;
+        tiles.back().row = it->row;
+        tiles.back().paths.swap(it->paths);
+      }
+    } else {
+      CutTiles(below, col1, is_horz ? col2 : mid, row1, is_horz ? mid : row2, 
+        tiles, 1);
+      CutTiles(above, is_horz ? col1 : mid, col2, is_horz ? mid : row1, row2, 
+        tiles, 1);
+    }
+  }
+  //------------------------------------------------------------------------------
+
+  void TileCutter::CutWorker(WorkerJob *worker_job)
+  {
+    CutJob *job = static_cast<CutJob*>(worker_job);
+    for (;;) {
+      size_t i = job->next++;
+      if (i >= 2 || job->failed) break;
+      job->owner->CutTiles(*job->paths[i], job->col1[i], job->col2[i], 
+        job->row1[i], job->row2[i], *job->tiles[i], job->thread_cnt[i]);
+    }
+  }
+  //------------------------------------------------------------------------------
+
+  void TileCutter::Execute(Tiles &tiles, unsigned thread_cnt)
+  {
+    tiles.clear();
+    if (paths_.empty()) return;
+    int64_t left = paths_[0][0].x, right = left, top = paths_[0][0].y, bottom = top;
+    for (Paths::const_iterator p = paths_.begin(); p != paths_.end(); ++p)
+      for (Path::const_iterator pt = p->begin(); pt != p->end(); ++pt) {
+        if (pt->x < left) left = pt->x;
+        else if (pt->x > right) right = pt->x;
+        if (pt->y < top) top = pt->y;
+        else if (pt->y > bottom) bottom = pt->y;
+      }
+    //get the range of tiles (inc. their margins) that overlap these bounds ...
+    int64_t col1 = FloorDiv(left - origin_.x - margin_, tile_size_);
+    int64_t col2 = FloorDiv(right - origin_.x + margin_, tile_size_) + 1;
+    int64_t row1 = FloorDiv(top - origin_.y - margin_, tile_size_);
+    int64_t row2 = FloorDiv(bottom - origin_.y + margin_, tile_size_) + 1;
+
+    if (!thread_cnt) thread_cnt = std::thread::hardware_concurrency();
+    Paths paths = paths_;
+    CutTiles(paths, col1, col2, row1, row2, tiles, thread_cnt);
+    std::sort(tiles.begin(), tiles.end(), TileLess);
+  }
+  //------------------------------------------------------------------------------
+
+} //namespace
@@ -0,0 +1,60 @@
+/*******************************************************************************
+* Author    :  Angus Johnson                                                   *
+* Version   :  10.0 (beta)                                                     *
+* Date      :  8 November 2017                                                 *
+* Website   :  http://www.angusj.com                                           *
+* Copyright :  Angus Johnson 2010-2017                                         *
+* Purpose   :  Cuts polygons into the tiles of a regular grid (in one pass)    *
+* License   :  http://www.boost.org/LICENSE_1_0.txt                            *
+*******************************************************************************/
+
+#ifndef clipper_tiles_h
+#define clipper_tiles_h
+
+#include <vector>
+#include <cstdlib>
+#include "clipper.h"
+
+namespace clipperlib {
+
+  struct Tile {
+    int64_t col;
+    int64_t row;
+    Paths paths;
+  };
+
+  typedef std::vector< Tile > Tiles;
+
+  //TileCutter: cuts closed paths into square tiles that are tile_size >> level
+  //wide, with tile (0,0)'s top-left corner at origin. Each tile also includes
+  //the geometry within margin of its edges. The paths are split recursively 
+  //along grid lines, so each level of recursion reads the geometry only once.
+  //Cut paths keep their fill (using either fill rule) but may have edges that
+  //overlap along the cut lines (eg where a concave polygon leaves and then
+  //reenters a tile). Clipper's ctUnion will remove these if that's a problem.
+  class TileCutter
+  {
+  private:
+    Paths paths_;
+    Point64 origin_;
+    int64_t tile_size_;
+    int64_t margin_;
+    struct CutJob;
+    void CutTiles(Paths &paths, int64_t col1, int64_t col2, 
+      int64_t row1, int64_t row2, Tiles &tiles, unsigned thread_cnt);
+    static void CutWorker(WorkerJob *worker_job);
+  public:
+    TileCutter(const Point64 &origin, int64_t tile_size, unsigned level = 0, 
+      int64_t margin = 0);
+    void Clear() { paths_.clear(); }
+    void AddPath(const Path &path);
+    void AddPaths(const Paths &paths);
+    //Execute: returns only tiles that aren't empty, ordered by row then col.
+    //Sub-grids are cut by up to thread_cnt threads (0: one per hardware thread).
+    void Execute(Tiles &tiles, unsigned thread_cnt = 0);
+    Rect64 TileRect(int64_t col, int64_t row) const; //nb: excludes margin
+  };
+
+} //namespace
+
+#endif //clipper_tiles_h
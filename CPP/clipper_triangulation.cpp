@@ -12,6 +12,7 @@
 #include <cmath>
 #include <vector>
 #include <algorithm>
+#include <new>
 #include <iostream>
 #include "clipper_triangulation.h"
 #include "clipper.h"
@@ -22,6 +23,31 @@
 
 namespace clipperlib {
 
+  //each worker thread takes this many shapes at a time ...
+  #define TRI_CHUNK_SIZE (16)
+
+  enum PathClass { pcComplex, pcConvex, pcMonotone };
+
+  //MonoPt: a vertex of a Y-monotone path, and whether it's on the chain that
+  //follows the path's own direction (from its bottom vertex up to its top).
+  struct MonoPt {
+    Point64 pt;
+    bool is_fwd;
+  };
+
+  //TriBuffers: scratch space that's reused for each path a thread triangulates
+  struct TriBuffers {
+    Path pts;
+    std::vector< MonoPt > merged;
+    std::vector< size_t > stack;
+  };
+
+  struct TriJob : public WorkerJob {
+    const PathsList *shapes;
+    PathsList *triangles;
+    FillRule fill_rule;
+  };
+
   //------------------------------------------------------------------------------
   // Miscellaneous functions ...
   //------------------------------------------------------------------------------
@@ -62,13 +88,13 @@ namespace clipperlib {
   }
   //------------------------------------------------------------------------------
 
-  inline void DisposeOutPt(OutPt *op)
+  inline void DisposeOutPt(OutPt *op, MemArena &arena)
   {
     if (op->prev) op->prev->next = op->next;
     if (op->next) op->next->prev = op->prev;
     OutPtTri *opt = static_cast<OutPtTri *>(op);
     if (opt->right_outrec) opt->right_outrec->left_outpt = NULL;
-    delete op;
+    arena.Free(op);
   }
   //------------------------------------------------------------------------------
 
@@ -111,9 +137,9 @@ namespace clipperlib {
   }
   //------------------------------------------------------------------------------
 
-  OutPtTri* InsertPt(const Point64 &pt, OutPt *insert_after)
+  OutPtTri* InsertPt(const Point64 &pt, OutPt *insert_after, MemArena &arena)
   {
-    OutPtTri *result = new OutPtTri();
+    OutPtTri *result = new (arena.Alloc()) OutPtTri();
     result->pt = pt;
     result->prev = insert_after;
     result->next = insert_after->next;
@@ -141,7 +167,7 @@ namespace clipperlib {
 
   OutPt* ClipperTri::CreateOutPt()
   {
-    OutPtTri *result = new OutPtTri();
+    OutPtTri *result = new (outpt_arena_.Alloc()) OutPtTri();
     result->outrec = NULL;
     result->right_outrec = NULL;
     return result;
@@ -150,7 +176,7 @@ namespace clipperlib {
 
   OutRec* ClipperTri::CreateOutRec()
   {
-    OutRecTri *result = new OutRecTri();
+    OutRecTri *result = new (outrec_arena_.Alloc()) OutRecTri();
     result->left_outpt = NULL;
     return result;
   }
@@ -174,7 +200,7 @@ namespace clipperlib {
           if (CrossProductVal(op2->pt, op->pt, op->prev->prev->pt, cpval) > 0) {
             OutPtTri *opt = static_cast<OutPtTri *>(op);
             if (opt->outrec) UpdateHelper(opt->outrec, op2);
-            DisposeOutPt(op);
+            DisposeOutPt(op, outpt_arena_);
             op = op2;
             continue;
           }
@@ -186,7 +212,7 @@ namespace clipperlib {
       if (cpval) AddPolygon(op->pt, op->prev->pt, op->prev->prev->pt);
       OutPtTri *opt = static_cast<OutPtTri *>(op->prev);
       if (opt->outrec) UpdateHelper(opt->outrec, op);
-      DisposeOutPt(op->prev);
+      DisposeOutPt(op->prev, outpt_arena_);
       if (op != outrec->pts) op = op->next;
     }
   }
@@ -225,7 +251,7 @@ namespace clipperlib {
 
     if (!botLft || botRt->pt.y < botLft->pt.y) botLft = botRt;
 
-    botRt = InsertPt(botLft->pt, botLft->prev);
+    botRt = InsertPt(botLft->pt, botLft->prev, outpt_arena_);
     OutRec *botOr = static_cast<OutPtTri *>(botLft)->outrec;
     if (!botOr->pts) botOr = botOr->owner;
 
@@ -235,7 +261,7 @@ namespace clipperlib {
     locMinOr->flag = orOuter;
     locMinOr->owner = NULL;
     OutPt *locMinLft = locMinOr->pts;
-    OutPt *locMinRt = InsertPt(locMinLft->pt, locMinLft);
+    OutPt *locMinRt = InsertPt(locMinLft->pt, locMinLft, outpt_arena_);
 
     //locMinOr will contain the polygon to the right of the join (ascending),
     //and botOr will contain the polygon to the left of the join (descending).
@@ -304,10 +330,13 @@ namespace clipperlib {
   bool ClipperTri::Execute(ClipType clipType, Paths &solution, FillRule fr) 
   {
     solution.clear();
+    triangles_.clear();
     if (clipType == ctNone) return true;
     bool result = ExecuteInternal(clipType, fr); 
     if (result) BuildResult(solution);
     CleanUp();
+    outpt_arena_.Clear();
+    outrec_arena_.Clear();
     return result;
   }
   //------------------------------------------------------------------------------
@@ -330,4 +359,229 @@ namespace clipperlib {
   }
   //------------------------------------------------------------------------------
 
+  //------------------------------------------------------------------------------
+  // Shape triangulation (without a sweep where possible) ...
+  //------------------------------------------------------------------------------
+
+  static inline double CrossProduct(const Point64 &pt1, const Point64 &pt2, const Point64 &pt3)
+  {
+    return double(pt2.x - pt1.x) * double(pt3.y - pt2.y) -
+      double(pt2.y - pt1.y) * double(pt3.x - pt2.x);
+  }
+  //------------------------------------------------------------------------------
+
+  static inline bool PointLess(const Point64 &pt1, const Point64 &pt2)
+  {
+    //nb: ordering by Y then X means horizontal edges needn't be special cases
+    return (pt1.y != pt2.y) ? pt1.y < pt2.y : pt1.x < pt2.x;
+  }
+  //------------------------------------------------------------------------------
+
+  static inline void AddTriangle(const Point64 &pt1, const Point64 &pt2, 
+    const Point64 &pt3, Paths &triangles)
+  {
+    //triangles are oriented like those from ClipperTri, and slivers are skipped
+    double cp = CrossProduct(pt1, pt2, pt3);
+    if (cp == 0) return;
+    Path p(3);
+    p[0] = pt1;
+    p[1] = (cp > 0) ? pt2 : pt3;
+    p[2] = (cp > 0) ? pt3 : pt2;
+    triangles.push_back(p);
+  }
+  //------------------------------------------------------------------------------
+
+  static PathClass ClassifyPath(const Path &path, TriBuffers &buf, 
+    size_t &bot_idx, size_t &top_idx, double &area)
+  {
+    //copy the path without its duplicate vertices ...
+    Path &pts = buf.pts;
+    pts.resize(0);
+    for (Path::const_iterator it = path.begin(); it != path.end(); ++it)
+      if (pts.empty() || *it != pts.back()) pts.push_back(*it);
+    while (pts.size() > 1 && pts.back() == pts[0]) pts.pop_back();
+    size_t cnt = pts.size();
+    area = 0;
+    if (cnt < 3) return pcConvex; //ie nothing to triangulate
+
+    //a path is monotone when it has just one bottom and one top vertex, and
+    //it's convex when also every turn is in the same direction ...
+    size_t bot_cnt = 0;
+    bool has_left = false, has_right = false;
+    for (size_t i = 0, prev = cnt - 1; i < cnt; prev = i, ++i) {
+      size_t next = (i + 1 == cnt) ? 0 : i + 1;
+      area += double(pts[prev].x) * double(pts[i].y) - double(pts[i].x) * double(pts[prev].y);
+      double cp = CrossProduct(pts[prev], pts[i], pts[next]);
+      if (cp > 0) has_left = true; else if (cp < 0) has_right = true;
+      if (PointLess(pts[i], pts[prev]) && PointLess(pts[i], pts[next])) {
+        bot_cnt++;
+        bot_idx = i;
+      }
+      else if (PointLess(pts[prev], pts[i]) && PointLess(pts[next], pts[i]))
+        top_idx = i;
+    }
+    if (bot_cnt != 1) return pcComplex;
+    if (!has_left || !has_right) return pcConvex;
+
+    //merge the two chains from bottom to top, making sure they don't touch
+    //or cross: every vertex must be on the same side of the other chain ...
+    std::vector< MonoPt > &merged = buf.merged;
+    merged.resize(cnt);
+    size_t fwd_cnt = (top_idx + cnt - bot_idx) % cnt, rev_cnt = cnt - fwd_cnt;
+    size_t f = 1, r = 1;
+    int side = 0;
+    merged[0].pt = pts[bot_idx];
+    merged[0].is_fwd = false;
+    for (size_t i = 1; i < cnt - 1; ++i) {
+      const Point64 &fwd_pt = pts[(bot_idx + f) % cnt];
+      const Point64 &rev_pt = pts[(bot_idx + cnt - r) % cnt];
+      int s;
+      if (f < fwd_cnt && PointLess(fwd_pt, rev_pt)) {
+        double cp = CrossProduct(pts[(bot_idx + cnt - r + 1) % cnt], rev_pt, fwd_pt);
+        s = (cp > 0) ? 1 : (cp < 0) ? -1 : 0;
+        merged[i].pt = fwd_pt;
+        merged[i].is_fwd = true;
+        ++f;
+      }
+      else {
+        double cp = CrossProduct(pts[(bot_idx + f - 1) % cnt], fwd_pt, rev_pt);
+        s = (cp > 0) ? -1 : (cp < 0) ? 1 : 0;
+        merged[i].pt = rev_pt;
+        merged[i].is_fwd = false;
+        ++r;
+      }
+      if (!s || (side && s != side)) return pcComplex;
+      side = s;
+    }
+    merged[cnt - 1].pt = pts[top_idx];
+    merged[cnt - 1].is_fwd = false;
+    return (f == fwd_cnt && r == rev_cnt) ? pcMonotone : pcComplex;
+  }
+  //------------------------------------------------------------------------------
+
+  static void TriangulateMonotone(TriBuffers &buf, double area, Paths &triangles)
+  {
+    //the standard stack based algorithm (see eg "Computational Geometry" by 
+    //de Berg et al), where the stack holds a reflex chain of vertices that
+    //are still waiting for diagonals ...
+    std::vector< MonoPt > &merged = buf.merged;
+    std::vector< size_t > &stack = buf.stack;
+    size_t cnt = merged.size();
+    stack.resize(0);
+    stack.push_back(0);
+    stack.push_back(1);
+    for (size_t i = 2; i < cnt - 1; ++i) {
+      const MonoPt &curr = merged[i];
+      if (curr.is_fwd != merged[stack.back()].is_fwd) {
+        //on the opposite chain so every vertex on the stack can be joined ...
+        while (stack.size() > 1) {
+          size_t j = stack.back();
+          stack.pop_back();
+          AddTriangle(curr.pt, merged[j].pt, merged[stack.back()].pt, triangles);
+        }
+        stack[0] = i - 1;
+        stack.push_back(i);
+      }
+      else {
+        //on the same chain, so join vertices while the diagonals are inside
+        size_t last = stack.back();
+        stack.pop_back();
+        while (!stack.empty()) {
+          double cp = CrossProduct(merged[stack.back()].pt, merged[last].pt, curr.pt);
+          if (!curr.is_fwd) cp = -cp;
+          if ((area > 0) ? cp <= 0 : cp >= 0) break;
+          AddTriangle(curr.pt, merged[last].pt, merged[stack.back()].pt, triangles);
+          last = stack.back();
+          stack.pop_back();
+        }
+        stack.push_back(last);
+        stack.push_back(i);
+      }
+    }
+    const Point64 &top_pt = merged[cnt - 1].pt;
+    while (stack.size() > 1) {
+      size_t j = stack.back();
+      stack.pop_back();
+      AddTriangle(top_pt, merged[j].pt, merged[stack.back()].pt, triangles);
+    }
+  }
+  //------------------------------------------------------------------------------
+
+  static bool TriangulatePath(const Path &path, FillRule fr, TriBuffers &buf,
+    Paths &triangles)
+  {
+    size_t bot_idx = 0, top_idx = 0;
+    double area;
+    PathClass pc = ClassifyPath(path, buf, bot_idx, top_idx, area);
+    if (pc == pcComplex) return false;
+    //simple paths are filled unless their winding direction is excluded ...
+    if ((fr == frPositive && area < 0) || (fr == frNegative && area > 0)) return true;
+    if (pc == pcConvex) {
+      const Path &pts = buf.pts;
+      for (size_t i = 2; i < pts.size(); ++i)
+        AddTriangle(pts[0], pts[i - 1], pts[i], triangles);
+    }
+    else
+      TriangulateMonotone(buf, area, triangles);
+    return true;
+  }
+  //------------------------------------------------------------------------------
+
+  static void TriangulateShape(const Paths &shape, Paths &triangles, 
+    FillRule fr, TriBuffers &buf, ClipperTri &clipper)
+  {
+    triangles.clear();
+    if (shape.size() == 1 && TriangulatePath(shape[0], fr, buf, triangles)) return;
+    triangles.clear();
+    clipper.Clear();
+    clipper.AddPaths(shape, ptSubject);
+    clipper.Execute(ctUnion, triangles, fr);
+  }
+  //------------------------------------------------------------------------------
+
+  void TriangulateShape(const Paths &shape, Paths &triangles, FillRule fr)
+  {
+    TriBuffers buf;
+    ClipperTri clipper;
+    TriangulateShape(shape, triangles, fr, buf, clipper);
+  }
+  //------------------------------------------------------------------------------
+
+  static void TriangulateWorker(WorkerJob *worker_job)
+  {
+    TriJob *job = static_cast<TriJob*>(worker_job);
+    TriBuffers buf;
+    ClipperTri clipper;
+    const PathsList &shapes = *job->shapes;
+    for (;;) {
+      size_t start = job->next.fetch_add(TRI_CHUNK_SIZE);
+      if (start >= shapes.size() || job->failed) break;
+      size_t end = std::min(start + TRI_CHUNK_SIZE, shapes.size());
+      for (size_t i = start; i < end; ++i)
+        TriangulateShape(shapes[i], (*job->triangles)[i], job->fill_rule, buf, clipper);
+    }
+  }
+  //------------------------------------------------------------------------------
+
+  void TriangulateShapes(const PathsList &shapes, PathsList &triangles, 
+    FillRule fr, unsigned thread_cnt)
+  {
+    triangles.clear();
+    triangles.resize(shapes.size());
+
+    TriJob job;
+    job.shapes = &shapes;
+    job.triangles = &triangles;
+    job.fill_rule = fr;
+    size_t chunk_cnt = (shapes.size() + TRI_CHUNK_SIZE - 1) / TRI_CHUNK_SIZE;
+    try {
+      RunWorkers(job, TriangulateWorker, thread_cnt, chunk_cnt);
+    }
+    catch (...) {
+      triangles.clear();
+      throw;
+    }
+  }
+  //------------------------------------------------------------------------------
+
 } //namespace
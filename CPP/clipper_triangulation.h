@@ -35,6 +35,8 @@ namespace clipperlib {
   {
   private:
     OutPt *last_op_;
+    MemArena outpt_arena_;
+    MemArena outrec_arena_;
     Paths triangles_;
     void  AddPolygon(const Point64 pt1, const Point64 pt2, const Point64 pt3);
     void  Triangulate(OutRec *outrec);
@@ -46,6 +48,8 @@ namespace clipperlib {
     void AddLocalMinPoly(Active &e1, Active &e2, const Point64 pt);
     void AddLocalMaxPoly(Active &e1, Active &e2, const Point64 pt);
   public:
+    explicit ClipperTri(MemoryResource *mr = NULL) : Clipper(mr), 
+      outpt_arena_(sizeof(OutPtTri), mr), outrec_arena_(sizeof(OutRecTri), mr) {}
     bool Execute(ClipType clipType, Paths &solution, FillRule fr = frEvenOdd);
     bool Execute(ClipType clipType, Paths &solution_closed, Paths &solution_open, FillRule fr = frEvenOdd)
       { return false; } //it's pointless triangulating open paths
@@ -53,6 +57,17 @@ namespace clipperlib {
     { return false; } //the PolyTree structure is of no benefit when triangulating 
   };
 
+  //TriangulateShape: triangulates a shape (ie a polygon with any holes). Most
+  //shapes are a single simple path, so these are classified first: convex
+  //paths are fan triangulated and paths that are simple and monotone in Y are
+  //triangulated in linear time. Only other shapes need ClipperTri's sweep.
+  void TriangulateShape(const Paths &shape, Paths &triangles, FillRule fr = frEvenOdd);
+
+  //TriangulateShapes: triangulates each shape (see above), sharing the shapes
+  //among thread_cnt threads (0: one per hardware thread).
+  void TriangulateShapes(const PathsList &shapes, PathsList &triangles, 
+    FillRule fr = frEvenOdd, unsigned thread_cnt = 0);
+
 } //namespace
 
 #endif //clipper_tri_h